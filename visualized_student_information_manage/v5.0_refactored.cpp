@@ -16,9 +16,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <windows.h>
 #include <graphics.h>
 #include <conio.h>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <type_traits>
+#include <thread>
+#include <algorithm>
+#include <memory>
+#include <random>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // ==================== 常量定义 ====================
 namespace Config {
@@ -26,10 +39,19 @@ namespace Config {
     constexpr int MAX_COURSES = 6;
     constexpr int MAX_NAME_LEN = 20;
     constexpr int MAX_PATH_LEN = 128;
+    constexpr int MAX_METRICS = 8;
+    constexpr int MAX_POINT_LEVELS = 12;    // 绩点换算表的最大档数
+    
+    // 并行处理阈值, 学生数低于此值时单线程执行
+    constexpr int PARALLEL_THRESHOLD = 16384;
+    constexpr int MAX_WORKER_THREADS = 16;
+    
+    // 索引文件页缓存的页数上限 (每页 4KB)
+    constexpr int INDEX_CACHE_PAGES = 64;
     
     // GUI 常量
     constexpr int MENU_WIDTH = 800;
-    constexpr int MENU_HEIGHT = 600;
+    constexpr int MENU_HEIGHT = 700;
     constexpr int DISPLAY_WIDTH = 1240;
     constexpr int DISPLAY_HEIGHT = 960;
     constexpr int BUTTON_WIDTH = 200;
@@ -44,6 +66,676 @@ namespace Config {
     constexpr float GRADE_D_MIN = 60.0f;
 }
 
+// ==================== 性能统计 ====================
+// 关闭时每个埋点只有一次原子读取; 开启后按线程累计次数和延迟直方图,
+// 可选地把每次调用记录为 Chrome trace 事件 (chrome://tracing 可直接打开)
+namespace Profiler {
+    enum Operation {
+        OP_LOAD = 0,
+        OP_SAVE,
+        OP_SORT,
+        OP_SEARCH,
+        OP_STATS,
+        OP_COUNT
+    };
+
+    static const char* const OP_NAMES[OP_COUNT] = {"load", "save", "sort", "search", "stats"};
+
+    // HDR 风格的对数-线性分桶: 按最高位分组, 每组再细分 SUB_BUCKETS 个子桶,
+    // 桶宽不超过下界的 1/SUB_BUCKETS, 百分位取桶中点后误差约 0.8%
+    constexpr int SUB_BUCKET_BITS = 6;
+    constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    constexpr int BUCKET_COUNT = 64 * SUB_BUCKETS;
+    constexpr int MAX_THREADS = 64;
+    constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    struct OpStats {
+        unsigned long long count;
+        unsigned long long totalNs;
+        unsigned long long maxNs;
+        unsigned long long buckets[BUCKET_COUNT];
+    };
+
+    // 线程自己的计数块: 只有所属线程写入, 但汇总和清零在其他线程进行, 故用 relaxed 原子
+    struct AtomicOpStats {
+        std::atomic<unsigned long long> count;
+        std::atomic<unsigned long long> totalNs;
+        std::atomic<unsigned long long> maxNs;
+        std::atomic<unsigned long long> buckets[BUCKET_COUNT];
+
+        void clear() {
+            count.store(0, std::memory_order_relaxed);
+            totalNs.store(0, std::memory_order_relaxed);
+            maxNs.store(0, std::memory_order_relaxed);
+            for (int b = 0; b < BUCKET_COUNT; b++) {
+                buckets[b].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    struct TraceEvent {
+        const char* name;
+        int op;
+        unsigned int tid;
+        long long startUs;
+        long long durationUs;
+    };
+
+    inline int bucketOf(unsigned long long ns) {
+        if (ns < SUB_BUCKETS) return (int)ns;
+        int msb = 63;
+        while (!(ns >> msb)) msb--;
+        int sub = (int)((ns >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    // 桶的下界
+    inline unsigned long long bucketLowerBound(int bucket) {
+        if (bucket < SUB_BUCKETS) return (unsigned long long)bucket;
+        int msb = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        unsigned long long sub = (unsigned long long)(bucket % SUB_BUCKETS);
+        return (1ULL << msb) | (sub << (msb - SUB_BUCKET_BITS));
+    }
+
+    // 桶的中点, 用于估算百分位 (取下界会系统性偏低)
+    inline unsigned long long bucketMidpoint(int bucket) {
+        if (bucket < SUB_BUCKETS) return (unsigned long long)bucket;
+        int msb = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        return bucketLowerBound(bucket) + (1ULL << (msb - SUB_BUCKET_BITS)) / 2;
+    }
+
+    struct ThreadSlot;
+
+    // 全局状态: 开关, 已注册线程的统计块, 已退出线程的合并结果, trace 缓冲
+    struct Registry {
+        std::atomic<bool> enabled{false};
+        std::atomic<bool> tracing{false};
+        std::mutex lock;
+        ThreadSlot* slots[MAX_THREADS] = {};
+        OpStats retired[OP_COUNT] = {};
+        unsigned int nextTid = 1;
+        std::vector<TraceEvent> traceEvents;
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    };
+
+    inline Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    inline void mergeStats(OpStats& dst, const AtomicOpStats& src) {
+        dst.count += src.count.load(std::memory_order_relaxed);
+        dst.totalNs += src.totalNs.load(std::memory_order_relaxed);
+        unsigned long long maxNs = src.maxNs.load(std::memory_order_relaxed);
+        if (maxNs > dst.maxNs) dst.maxNs = maxNs;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            dst.buckets[b] += src.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    // 每个线程独占一份计数, 记录时无需加锁; 线程退出时并入 retired
+    struct ThreadSlot {
+        AtomicOpStats ops[OP_COUNT];
+        unsigned int tid;
+        int slotIndex;
+
+        ThreadSlot() : tid(0), slotIndex(-1) {
+            for (int op = 0; op < OP_COUNT; op++) {
+                ops[op].clear();
+            }
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> guard(reg.lock);
+            tid = reg.nextTid++;
+            for (int i = 0; i < MAX_THREADS; i++) {
+                if (!reg.slots[i]) {
+                    reg.slots[i] = this;
+                    slotIndex = i;
+                    break;
+                }
+            }
+        }
+
+        ~ThreadSlot() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> guard(reg.lock);
+            for (int op = 0; op < OP_COUNT; op++) {
+                mergeStats(reg.retired[op], ops[op]);
+            }
+            if (slotIndex >= 0) reg.slots[slotIndex] = nullptr;
+        }
+    };
+
+    inline ThreadSlot& localSlot() {
+        thread_local ThreadSlot slot;
+        return slot;
+    }
+
+    inline bool isEnabled() {
+        return registry().enabled.load(std::memory_order_relaxed);
+    }
+
+    inline void setEnabled(bool on) {
+        registry().enabled.store(on, std::memory_order_relaxed);
+    }
+
+    inline bool isTracing() {
+        return registry().tracing.load(std::memory_order_relaxed);
+    }
+
+    // 开启 trace 会同时开启统计
+    inline void setTracing(bool on) {
+        registry().tracing.store(on, std::memory_order_relaxed);
+        if (on) setEnabled(true);
+    }
+
+    inline void record(Operation op, const char* name,
+                       std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end) {
+        unsigned long long ns = (unsigned long long)
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        // reset() 可能在其他线程同时清零, 计数用 fetch_add 避免写回旧值
+        ThreadSlot& slot = localSlot();
+        AtomicOpStats& stats = slot.ops[op];
+        stats.count.fetch_add(1, std::memory_order_relaxed);
+        stats.totalNs.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > stats.maxNs.load(std::memory_order_relaxed)) {
+            stats.maxNs.store(ns, std::memory_order_relaxed);
+        }
+        stats.buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+
+        if (isTracing()) {
+            Registry& reg = registry();
+            TraceEvent event;
+            event.name = name;
+            event.op = op;
+            event.tid = slot.tid;
+            event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - reg.epoch).count();
+            event.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+            std::lock_guard<std::mutex> guard(reg.lock);
+            if (reg.traceEvents.size() < MAX_TRACE_EVENTS) {
+                reg.traceEvents.push_back(event);
+            }
+        }
+    }
+
+    // 作用域计时器 - 构造时读取开关, 关闭时不取时间戳
+    class ScopedTimer {
+    private:
+        Operation op;
+        const char* name;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        ScopedTimer(Operation operation, const char* eventName)
+            : op(operation), name(eventName), active(isEnabled()) {
+            if (active) start = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer() {
+            if (active) record(op, name, start, std::chrono::steady_clock::now());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+    // 汇总所有线程 (含已退出线程) 的统计
+    inline void snapshot(OpStats out[OP_COUNT]) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> guard(reg.lock);
+        memcpy(out, reg.retired, sizeof(reg.retired));
+        for (int i = 0; i < MAX_THREADS; i++) {
+            if (!reg.slots[i]) continue;
+            for (int op = 0; op < OP_COUNT; op++) {
+                mergeStats(out[op], reg.slots[i]->ops[op]);
+            }
+        }
+    }
+
+    inline unsigned long long percentile(const OpStats& stats, double p) {
+        if (stats.count == 0) return 0;
+        unsigned long long target = (unsigned long long)(stats.count * p);
+        if (target >= stats.count) target = stats.count - 1;
+        unsigned long long seen = 0;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            seen += stats.buckets[b];
+            if (seen > target) {
+                unsigned long long value = bucketMidpoint(b);
+                return value < stats.maxNs ? value : stats.maxNs;
+            }
+        }
+        return stats.maxNs;
+    }
+
+    inline void reset() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> guard(reg.lock);
+        memset(reg.retired, 0, sizeof(reg.retired));
+        for (int i = 0; i < MAX_THREADS; i++) {
+            if (!reg.slots[i]) continue;
+            for (int op = 0; op < OP_COUNT; op++) {
+                reg.slots[i]->ops[op].clear();
+            }
+        }
+        reg.traceEvents.clear();
+    }
+
+    // 输出统计表, 时间单位为微秒
+    inline void dump(FILE* out) {
+        // 直方图较大, 放在堆上
+        std::vector<OpStats> stats(OP_COUNT);
+        snapshot(stats.data());
+
+        fprintf(out, "\n%-10s%-10s%-12s%-12s%-12s%-12s%-12s\n",
+                "Op", "Count", "Avg(us)", "P50(us)", "P90(us)", "P99(us)", "Max(us)");
+        for (int i = 0; i < 80; i++) fputc('-', out);
+        fputc('\n', out);
+
+        for (int op = 0; op < OP_COUNT; op++) {
+            const OpStats& s = stats[op];
+            double avg = s.count > 0 ? (double)s.totalNs / s.count : 0;
+            fprintf(out, "%-10s%-10llu%-12.2f%-12.2f%-12.2f%-12.2f%-12.2f\n",
+                    OP_NAMES[op], s.count, avg / 1000.0,
+                    percentile(s, 0.50) / 1000.0,
+                    percentile(s, 0.90) / 1000.0,
+                    percentile(s, 0.99) / 1000.0,
+                    s.maxNs / 1000.0);
+        }
+    }
+
+    // 以 Chrome trace JSON 格式写出已记录的事件
+    inline bool writeTrace(const char* filepath) {
+        FILE* file = fopen(filepath, "w");
+        if (!file) return false;
+
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> guard(reg.lock);
+
+        fprintf(file, "{\"traceEvents\":[\n");
+        for (size_t i = 0; i < reg.traceEvents.size(); i++) {
+            const TraceEvent& e = reg.traceEvents[i];
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u}\n",
+                    i > 0 ? "," : "", e.name, OP_NAMES[e.op], e.startUs, e.durationUs, e.tid);
+        }
+        fprintf(file, "]}\n");
+
+        fclose(file);
+        return true;
+    }
+}
+
+// ==================== 编码转换 ====================
+// 随附的数据文件为 GBK, 外部流水线多用 UTF-8. 读写文件时识别并转换编码,
+// 程序内部的字符串 (姓名, EasyX 与控制台输出) 统一使用系统 ANSI 编码.
+// 纯 ASCII 段按 16 字节批量扫描后直接拷贝, 只有中文段交给系统码表转换
+namespace TextCodec {
+    enum Encoding {
+        ENCODING_ASCII = 0,
+        ENCODING_UTF8,
+        ENCODING_GBK,
+        ENCODING_ANSI       // 其他系统 ANSI 代码页 (如 1252, 932, 950), 只作为程序内部编码
+    };
+    
+    static const char* const ENCODING_NAMES[] = {"ASCII", "UTF-8", "GBK", "ANSI"};
+    
+    // 保存时的默认编码, 与随附的数据文件保持一致
+    constexpr Encoding DEFAULT_FILE_ENCODING = ENCODING_GBK;
+    constexpr UINT GBK_CODE_PAGE = 936;
+    
+    // 从开头起连续 ASCII 字节的个数
+    inline size_t asciiRunLength(const char* text, size_t n) {
+        const unsigned char* p = (const unsigned char*)text;
+        size_t i = 0;
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+        for (; i + 16 <= n; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(p + i));
+            if (_mm_movemask_epi8(block) != 0) break;
+        }
+#endif
+        for (; i + 8 <= n; i += 8) {
+            unsigned long long word;
+            memcpy(&word, p + i, sizeof(word));
+            if (word & 0x8080808080808080ULL) break;
+        }
+        while (i < n && p[i] < 0x80) i++;
+        return i;
+    }
+    
+    // 单个 UTF-8 字符的字节数, 非法序列 (含过长编码与代理区) 返回 0
+    inline int utf8CharLength(const char* text, size_t n) {
+        const unsigned char* p = (const unsigned char*)text;
+        unsigned char c = p[0];
+        if (c < 0x80) return 1;
+        
+        int len;
+        unsigned int cp;
+        if (c >= 0xC2 && c <= 0xDF) { len = 2; cp = c & 0x1F; }
+        else if ((c & 0xF0) == 0xE0) { len = 3; cp = c & 0x0F; }
+        else if (c >= 0xF0 && c <= 0xF4) { len = 4; cp = c & 0x07; }
+        else return 0;
+        
+        if (n < (size_t)len) return 0;
+        for (int k = 1; k < len; k++) {
+            if ((p[k] & 0xC0) != 0x80) return 0;
+            cp = (cp << 6) | (p[k] & 0x3F);
+        }
+        if ((len == 3 && cp < 0x800) || (cp >= 0xD800 && cp <= 0xDFFF) ||
+            (len == 4 && (cp < 0x10000 || cp > 0x10FFFF))) {
+            return 0;
+        }
+        return len;
+    }
+    
+    // 单个 GBK 字符的字节数: 0x80 在代码页 936 中是单字节的欧元符号;
+    // 双字节字符首字节 0x81-0xFE, 尾字节 0x40-0xFE 且不为 0x7F
+    inline int gbkCharLength(const char* text, size_t n) {
+        const unsigned char* p = (const unsigned char*)text;
+        if (p[0] <= 0x80) return 1;
+        if (p[0] == 0xFF || n < 2) return 0;
+        if (p[1] < 0x40 || p[1] == 0x7F || p[1] == 0xFF) return 0;
+        return 2;
+    }
+    
+    // 系统 ANSI 代码页中单个字符的字节数, 双字节代码页的首字节由系统判断
+    inline int ansiCharLength(const char* text, size_t n) {
+        const unsigned char* p = (const unsigned char*)text;
+        if (p[0] < 0x80 || !IsDBCSLeadByte(p[0])) return 1;
+        return n >= 2 ? 2 : 0;
+    }
+    
+    inline int charLength(Encoding encoding, const char* text, size_t n) {
+        switch (encoding) {
+            case ENCODING_UTF8: return utf8CharLength(text, n);
+            case ENCODING_GBK:  return gbkCharLength(text, n);
+            case ENCODING_ANSI: return ansiCharLength(text, n);
+            default:            return (unsigned char)text[0] < 0x80 ? 1 : 0;
+        }
+    }
+    
+    inline bool validate(const char* text, size_t n, Encoding encoding) {
+        size_t i = 0;
+        while (i < n) {
+            i += asciiRunLength(text + i, n - i);
+            if (i >= n) break;
+            int len = charLength(encoding, text + i, n - i);
+            if (len == 0) return false;
+            i += len;
+        }
+        return true;
+    }
+    
+    // 不超过 maxBytes 且不截断多字节字符的最大长度
+    inline size_t fitLength(const char* text, size_t n, size_t maxBytes, Encoding encoding) {
+        if (n <= maxBytes) return n;
+        size_t i = 0;
+        while (i < maxBytes) {
+            int len = charLength(encoding, text + i, n - i);
+            if (len == 0) len = 1;
+            if (i + len > maxBytes) break;
+            i += len;
+        }
+        return i;
+    }
+    
+    // 含非 ASCII 字符且为合法 UTF-8 时判为 UTF-8, 否则按 GBK 处理
+    inline Encoding detect(const char* text, size_t n) {
+        size_t ascii = asciiRunLength(text, n);
+        if (ascii == n) return ENCODING_ASCII;
+        return validate(text + ascii, n - ascii, ENCODING_UTF8) ? ENCODING_UTF8 : ENCODING_GBK;
+    }
+    
+    inline Encoding nativeEncoding() {
+        UINT acp = GetACP();
+        if (acp == CP_UTF8) return ENCODING_UTF8;
+        return acp == GBK_CODE_PAGE ? ENCODING_GBK : ENCODING_ANSI;
+    }
+    
+    inline UINT codePageOf(Encoding encoding) {
+        switch (encoding) {
+            case ENCODING_GBK:  return GBK_CODE_PAGE;
+            case ENCODING_ANSI: return GetACP();
+            default:            return CP_UTF8;
+        }
+    }
+    
+    // 转换一段非 ASCII 字符并追加到 out. 含非法序列, 或有目标码表无法表示的字符时,
+    // 由系统码表替换并返回 false
+    inline bool convertSegment(const char* src, int len, Encoding from, Encoding to,
+                               std::string& out, std::vector<wchar_t>& wide) {
+        UINT fromPage = codePageOf(from);
+        int wideLen = MultiByteToWideChar(fromPage, MB_ERR_INVALID_CHARS, src, len, nullptr, 0);
+        bool valid = wideLen > 0;
+        if (!valid) wideLen = MultiByteToWideChar(fromPage, 0, src, len, nullptr, 0);
+        if (wideLen <= 0) return false;
+        
+        wide.resize(wideLen);
+        MultiByteToWideChar(fromPage, 0, src, len, wide.data(), wideLen);
+        
+        UINT toPage = codePageOf(to);
+        int outLen = WideCharToMultiByte(toPage, 0, wide.data(), wideLen, nullptr, 0, nullptr, nullptr);
+        if (outLen <= 0) return false;
+        
+        // 目标为 UTF-8 时系统要求 lpUsedDefaultChar 为空, 此时所有字符都能表示
+        BOOL usedDefault = FALSE;
+        size_t base = out.size();
+        out.resize(base + outLen);
+        WideCharToMultiByte(toPage, 0, wide.data(), wideLen, &out[base], outLen, nullptr, 
+                            toPage == CP_UTF8 ? nullptr : &usedDefault);
+        return valid && !usedDefault;
+    }
+    
+    // 编码相同时逐字符拷贝, 非法字节替换为 '?', 与转换路径一样保证输出合法
+    inline bool copyReplacingInvalid(const char* src, size_t n, Encoding encoding, std::string& out) {
+        out.reserve(n);
+        bool valid = true;
+        size_t i = 0;
+        while (i < n) {
+            size_t run = asciiRunLength(src + i, n - i);
+            out.append(src + i, run);
+            i += run;
+            if (i >= n) break;
+            
+            int len = charLength(encoding, src + i, n - i);
+            if (len == 0) {
+                out.push_back('?');
+                valid = false;
+                i++;
+            } else {
+                out.append(src + i, len);
+                i += len;
+            }
+        }
+        return valid;
+    }
+    
+    // 把 from 编码的文本转换为 to 编码写入 out, 文本全部合法时返回 true.
+    // ASCII 在两种编码中相同, 直接拷贝; 非 ASCII 段按字符边界切分后整段转换
+    inline bool transcode(const char* src, size_t n, Encoding from, Encoding to, std::string& out) {
+        out.clear();
+        if (from == ENCODING_ASCII || from == to) {
+            return copyReplacingInvalid(src, n, from, out);
+        }
+        
+        out.reserve(n + n / 2);
+        std::vector<wchar_t> wide;
+        bool valid = true;
+        size_t i = 0;
+        while (i < n) {
+            size_t run = asciiRunLength(src + i, n - i);
+            out.append(src + i, run);
+            i += run;
+            
+            size_t start = i;
+            while (i < n && (unsigned char)src[i] >= 0x80) {
+                int len = charLength(from, src + i, n - i);
+                i += len > 0 ? len : 1;
+            }
+            if (i > start && !convertSegment(src + start, (int)(i - start), from, to, out, wide)) {
+                valid = false;
+            }
+        }
+        return valid;
+    }
+}
+
+// ==================== 名单文本格式 ====================
+// 字段名以 UTF-8 字节写出, 不受编译器源文件字符集设置影响, 写文件时再转换到目标编码
+namespace RosterText {
+    static const char LABEL_STUDENT_COUNT[] = "\xE5\xAD\xA6\xE7\x94\x9F\xE6\x95\xB0\xE9\x87\x8F\xEF\xBC\x9A";  // 学生数量：
+    static const char LABEL_COURSE_COUNT[] = "\xE7\xA7\x91\xE7\x9B\xAE\xE6\x95\xB0\xE9\x87\x8F\xEF\xBC\x9A";   // 科目数量：
+    static const char LABEL_NAME[] = "\xE5\xA7\x93\xE5\x90\x8D: ";                                        // 姓名: 
+    static const char LABEL_ID[] = "\xE5\xAD\xA6\xE5\x8F\xB7: ";                                          // 学号: 
+    static const char LABEL_SCORES[] = "\xE5\x88\x86\xE6\x95\xB0: ";                                      // 分数: 
+    static const char LABEL_TOTAL[] = "\xE6\x80\xBB\xE5\x88\x86: ";                                       // 总分: 
+    static const char LABEL_AVERAGE[] = "\xE5\xB9\xB3\xE5\x9D\x87\xE5\x88\x86: ";                         // 平均分: 
+    static const char FULLWIDTH_COLON[] = "\xEF\xBC\x9A";                                                 // ：
+    
+    // 按字段顺序读取: 每个字段从下一个冒号 (半角或全角) 之后开始, 不依赖字段名的编码
+    class FieldReader {
+    private:
+        const char* cur;
+        const char* end;
+        TextCodec::Encoding encoding;
+        std::string wideColon;
+        
+        void skipSpaces() {
+            while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\r' || *cur == '\n')) cur++;
+        }
+        
+    public:
+        // text 需以 '\0' 结尾
+        FieldReader(const char* text, size_t n, TextCodec::Encoding textEncoding)
+            : cur(text), end(text + n), encoding(textEncoding) {
+            TextCodec::transcode(FULLWIDTH_COLON, strlen(FULLWIDTH_COLON), 
+                                 TextCodec::ENCODING_UTF8, encoding, wideColon);
+        }
+        
+        bool nextField() {
+            while (cur < end) {
+                if (*cur == ':') {
+                    cur++;
+                    return true;
+                }
+                if ((size_t)(end - cur) >= wideColon.size() && 
+                    memcmp(cur, wideColon.data(), wideColon.size()) == 0) {
+                    cur += wideColon.size();
+                    return true;
+                }
+                int len = TextCodec::charLength(encoding, cur, end - cur);
+                cur += len > 0 ? len : 1;
+            }
+            return false;
+        }
+        
+        bool readInt(int* value) {
+            long v;
+            if (!readLong(&v)) return false;
+            *value = (int)v;
+            return true;
+        }
+        
+        bool readLong(long* value) {
+            skipSpaces();
+            char* stop;
+            *value = strtol(cur, &stop, 10);
+            if (stop == cur) return false;
+            cur = stop;
+            return true;
+        }
+        
+        bool readFloat(float* value) {
+            skipSpaces();
+            char* stop;
+            *value = strtof(cur, &stop);
+            if (stop == cur) return false;
+            cur = stop;
+            return true;
+        }
+        
+        // 读取到空白为止的一个词, 过长时在字符边界截断
+        bool readToken(char* out, int maxLen) {
+            skipSpaces();
+            const char* start = cur;
+            while (cur < end && *cur != ' ' && *cur != '\t' && *cur != '\r' && *cur != '\n') cur++;
+            if (cur == start) return false;
+            
+            size_t len = TextCodec::fitLength(start, cur - start, maxLen - 1, encoding);
+            memcpy(out, start, len);
+            out[len] = '\0';
+            return true;
+        }
+    };
+}
+
+// ==================== 统计内核 ====================
+// 科目数在运行期只会取少数几个小值, 按科目数实例化模板后循环可完全展开.
+// 模板参数 N 为 0 时表示通用路径, 使用运行期传入的 count
+namespace Kernels {
+    template <int N>
+    using CourseCount = std::integral_constant<int, N>;
+    
+    // 把运行期科目数分派到 1..MAX_COURSES 的编译期特化, 其余走 N = 0
+    template <int N>
+    struct CourseDispatch {
+        template <typename Fn>
+        static void run(int courseCount, Fn& fn) {
+            if (courseCount == N) fn(CourseCount<N>());
+            else CourseDispatch<N - 1>::run(courseCount, fn);
+        }
+    };
+    
+    template <>
+    struct CourseDispatch<0> {
+        template <typename Fn>
+        static void run(int, Fn& fn) {
+            fn(CourseCount<0>());
+        }
+    };
+    
+    template <typename Fn>
+    inline void dispatchCourseCount(int courseCount, Fn fn) {
+        CourseDispatch<Config::MAX_COURSES>::run(courseCount, fn);
+    }
+    
+    template <int N>
+    inline float sumScores(const float* scores, int count) {
+        const int n = N > 0 ? N : count;
+        float total = 0;
+        for (int i = 0; i < n; i++) {
+            total += scores[i];
+        }
+        return total;
+    }
+    
+    // 逐科比较成绩是否完全一致, 两边都是 NaN 也视为相同
+    template <int N>
+    inline bool scoresEqual(const float* a, const float* b, int count) {
+        const int n = N > 0 ? N : count;
+        bool equal = true;
+        for (int i = 0; i < n; i++) {
+            equal &= (a[i] == b[i]) | ((a[i] != a[i]) & (b[i] != b[i]));
+        }
+        return equal;
+    }
+    
+    inline bool scoresEqual(const float* a, const float* b, int count) {
+        bool result = false;
+        dispatchCourseCount(count, [&](auto n) {
+            result = scoresEqual<decltype(n)::value>(a, b, count);
+        });
+        return result;
+    }
+    
+    // 等级下标 0-4 对应 A-E, 无分支写法便于向量化, 与逐级 if 判断结果一致 (NaN 计为 E)
+    inline int gradeIndex(float score) {
+        return !(score >= Config::GRADE_A_MIN) + !(score >= Config::GRADE_B_MIN) +
+               !(score >= Config::GRADE_C_MIN) + !(score >= Config::GRADE_D_MIN);
+    }
+}
+
 // ==================== 数据结构定义 ====================
 
 // 学生信息结构体 - 将总分和平均分整合进来
@@ -54,12 +746,17 @@ struct Student {
     float totalScore;   // 移入结构体
     float avgScore;     // 移入结构体
     
+    template <int N>
+    void calculateScoresFixed(int courseCount) {
+        const int n = N > 0 ? N : courseCount;
+        totalScore = Kernels::sumScores<N>(scores, courseCount);
+        avgScore = n > 0 ? totalScore / n : 0;
+    }
+    
     void calculateScores(int courseCount) {
-        totalScore = 0;
-        for (int i = 0; i < courseCount; i++) {
-            totalScore += scores[i];
-        }
-        avgScore = courseCount > 0 ? totalScore / courseCount : 0;
+        Kernels::dispatchCourseCount(courseCount, [&](auto n) {
+            calculateScoresFixed<decltype(n)::value>(courseCount);
+        });
     }
 };
 
@@ -71,166 +768,1745 @@ struct CourseStats {
     float gradePercent[5];
 };
 
-// 学生管理器 - 封装所有学生数据和操作
-class StudentManager {
-public:
-    Student students[Config::MAX_STUDENTS];
-    CourseStats courseStats[Config::MAX_COURSES];
-    int studentCount;
-    int courseCount;
+namespace Kernels {
+    // 按行遍历学生, 一次累加全部 N 门课程, 每个学生只读一遍
+    template <int N>
+    inline void computeCourseStats(const Student* students, int studentCount,
+                                   CourseStats* stats, int courseCount) {
+        const int n = N > 0 ? N : courseCount;
+        float totals[Config::MAX_COURSES] = {};
+        int grades[Config::MAX_COURSES][5] = {};
+        
+        for (int i = 0; i < studentCount; i++) {
+            const float* scores = students[i].scores;
+            for (int j = 0; j < n; j++) {
+                totals[j] += scores[j];
+                grades[j][gradeIndex(scores[j])]++;
+            }
+        }
+        
+        for (int j = 0; j < n; j++) {
+            stats[j].totalScore = totals[j];
+            stats[j].avgScore = studentCount > 0 ? totals[j] / studentCount : 0;
+            for (int k = 0; k < 5; k++) {
+                stats[j].gradeCount[k] = grades[j][k];
+                stats[j].gradePercent[k] = studentCount > 0 ? 
+                    (float)grades[j][k] / studentCount : 0;
+            }
+        }
+    }
     
-    StudentManager() : studentCount(0), courseCount(0) {
-        memset(students, 0, sizeof(students));
-        memset(courseStats, 0, sizeof(courseStats));
+    template <int N>
+    inline void computeStudentScores(Student* students, int studentCount, int courseCount) {
+        for (int i = 0; i < studentCount; i++) {
+            students[i].calculateScoresFixed<N>(courseCount);
+        }
     }
     
-    // 计算所有学生的总分和平均分
-    void calculateStudentScores() {
+    // 以下为按运行期科目数循环的参考实现, 保留用于基准测试对照和结果校验
+    inline void computeStudentScoresReference(Student* students, int studentCount, int courseCount) {
         for (int i = 0; i < studentCount; i++) {
-            students[i].calculateScores(courseCount);
+            Student& st = students[i];
+            st.totalScore = 0;
+            for (int j = 0; j < courseCount; j++) {
+                st.totalScore += st.scores[j];
+            }
+            st.avgScore = courseCount > 0 ? st.totalScore / courseCount : 0;
         }
     }
     
-    // 计算各科目统计信息
-    void calculateCourseStats() {
+    inline void computeCourseStatsReference(const Student* students, int studentCount,
+                                            CourseStats* stats, int courseCount) {
         for (int j = 0; j < courseCount; j++) {
-            courseStats[j].totalScore = 0;
-            memset(courseStats[j].gradeCount, 0, sizeof(courseStats[j].gradeCount));
+            stats[j].totalScore = 0;
+            memset(stats[j].gradeCount, 0, sizeof(stats[j].gradeCount));
             
             for (int i = 0; i < studentCount; i++) {
                 float score = students[i].scores[j];
-                courseStats[j].totalScore += score;
+                stats[j].totalScore += score;
                 
-                // 统计各等级人数
-                if (score >= Config::GRADE_A_MIN) courseStats[j].gradeCount[0]++;
-                else if (score >= Config::GRADE_B_MIN) courseStats[j].gradeCount[1]++;
-                else if (score >= Config::GRADE_C_MIN) courseStats[j].gradeCount[2]++;
-                else if (score >= Config::GRADE_D_MIN) courseStats[j].gradeCount[3]++;
-                else courseStats[j].gradeCount[4]++;
+                if (score >= Config::GRADE_A_MIN) stats[j].gradeCount[0]++;
+                else if (score >= Config::GRADE_B_MIN) stats[j].gradeCount[1]++;
+                else if (score >= Config::GRADE_C_MIN) stats[j].gradeCount[2]++;
+                else if (score >= Config::GRADE_D_MIN) stats[j].gradeCount[3]++;
+                else stats[j].gradeCount[4]++;
             }
             
-            courseStats[j].avgScore = studentCount > 0 ? 
-                courseStats[j].totalScore / studentCount : 0;
-            
-            // 计算百分比
+            stats[j].avgScore = studentCount > 0 ? stats[j].totalScore / studentCount : 0;
             for (int k = 0; k < 5; k++) {
-                courseStats[j].gradePercent[k] = studentCount > 0 ? 
-                    (float)courseStats[j].gradeCount[k] / studentCount : 0;
+                stats[j].gradePercent[k] = studentCount > 0 ? 
+                    (float)stats[j].gradeCount[k] / studentCount : 0;
+            }
+        }
+    }
+}
+
+// ==================== 派生列 ====================
+
+enum MetricAggregate {
+    METRIC_WEIGHTED_SUM = 0,    // sum(w * f(score))
+    METRIC_WEIGHTED_AVERAGE     // sum(w * f(score)) / sum(w)
+};
+
+// 成绩到绩点的分段换算表: 取不高于成绩的最高一档, 低于所有档 (或 NaN) 记 0 分
+struct PointScale {
+    int levelCount;
+    float minScore[Config::MAX_POINT_LEVELS];
+    float points[Config::MAX_POINT_LEVELS];
+    
+    float pointsOf(float score) const {
+        float best = 0;
+        float bestMin = 0;
+        bool found = false;
+        for (int k = 0; k < levelCount; k++) {
+            if (score >= minScore[k] && (!found || minScore[k] > bestMin)) {
+                best = points[k];
+                bestMin = minScore[k];
+                found = true;
+            }
+        }
+        return best;
+    }
+    
+    // 默认换算: A-E 对应 4-0
+    static PointScale gradeScale() {
+        PointScale scale;
+        memset(&scale, 0, sizeof(scale));
+        const float bounds[4] = {Config::GRADE_A_MIN, Config::GRADE_B_MIN, 
+                                 Config::GRADE_C_MIN, Config::GRADE_D_MIN};
+        for (int k = 0; k < 4; k++) {
+            scale.minScore[k] = bounds[k];
+            scale.points[k] = (float)(4 - k);
+        }
+        scale.levelCount = 4;
+        return scale;
+    }
+};
+
+// 派生指标的计算公式: 各科成绩 (可先经换算表映射) 按科目系数加权后求和或求加权平均
+struct MetricFormula {
+    MetricAggregate aggregate;
+    float weights[Config::MAX_COURSES];     // 各科系数, 如学分
+    bool usePoints;                         // 为 true 时 f(score) = scale.pointsOf(score)
+    PointScale scale;
+};
+
+// 派生指标 - 只保存定义, 取值时按需计算并缓存到数据变化为止
+struct DerivedMetric {
+    char name[Config::MAX_NAME_LEN];
+    MetricFormula formula;
+    float values[Config::MAX_STUDENTS];
+    unsigned long cachedVersion;    // 与 StudentManager::dataVersion 相等时缓存有效
+    bool cached;
+};
+
+namespace Kernels {
+    template <int N>
+    inline void computeMetric(const Student* students, int studentCount, int courseCount,
+                              const DerivedMetric& metric, float* out) {
+        const int n = N > 0 ? N : courseCount;
+        const MetricFormula& formula = metric.formula;
+        float weightSum = 0;
+        for (int j = 0; j < n; j++) {
+            weightSum += formula.weights[j];
+        }
+        const float scale = (formula.aggregate == METRIC_WEIGHTED_SUM || weightSum == 0) ? 
+            1.0f : 1.0f / weightSum;
+        
+        for (int i = 0; i < studentCount; i++) {
+            const float* scores = students[i].scores;
+            float acc = 0;
+            for (int j = 0; j < n; j++) {
+                float value = formula.usePoints ? formula.scale.pointsOf(scores[j]) : scores[j];
+                acc += formula.weights[j] * value;
+            }
+            out[i] = acc * scale;
+        }
+    }
+}
+
+// 排序视图 - 按不同顺序排列的学生下标, 可同时缓存多个
+enum SortView {
+    VIEW_NONE = -1,         // 原始录入顺序
+    VIEW_TOTAL_DESC = 0,
+    VIEW_TOTAL_ASC,
+    VIEW_ID,
+    VIEW_NAME,
+    VIEW_METRIC,            // 按派生列, 由 sortByMetric 指定
+    VIEW_COUNT
+};
+
+struct SortedView {
+    int order[Config::MAX_STUDENTS];       // 第 k 行对应的学生下标
+    int position[Config::MAX_STUDENTS];    // 学生下标所在的行, order 的逆
+    bool valid;
+};
+
+// 学生管理器 - 封装所有学生数据和操作
+class StudentManager {
+private:
+    SortedView views[VIEW_COUNT];
+    SortView activeView;
+    int viewMetric;
+    bool viewMetricAscending;
+    
+    // 按分数比较, 返回 -1/0/1; NaN 无论升序降序都排在最后, 保证仍是严格弱序
+    static int compareScores(float x, float y, bool ascending) {
+        bool nanX = x != x;
+        bool nanY = y != y;
+        if (nanX || nanY) return nanX == nanY ? 0 : (nanX ? 1 : -1);
+        if (x == y) return 0;
+        return (ascending ? x < y : x > y) ? -1 : 1;
+    }
+    
+    // 视图内的严格全序, 相等时按原始下标区分
+    bool viewLess(SortView view, int a, int b) const {
+        const Student& sa = students[a];
+        const Student& sb = students[b];
+        switch (view) {
+            case VIEW_TOTAL_DESC:
+            case VIEW_TOTAL_ASC: {
+                int cmp = compareScores(sa.totalScore, sb.totalScore, view == VIEW_TOTAL_ASC);
+                if (cmp != 0) return cmp < 0;
+                break;
+            }
+            case VIEW_ID:
+                if (sa.id != sb.id) return sa.id < sb.id;
+                break;
+            case VIEW_NAME: {
+                int cmp = strcmp(sa.name, sb.name);
+                if (cmp != 0) return cmp < 0;
+                break;
+            }
+            case VIEW_METRIC: {
+                const float* values = metrics[viewMetric].values;
+                int cmp = compareScores(values[a], values[b], viewMetricAscending);
+                if (cmp != 0) return cmp < 0;
+                break;
+            }
+            default:
+                break;
+        }
+        return a < b;
+    }
+    
+    void buildView(SortView view) {
+        Profiler::ScopedTimer timer(Profiler::OP_SORT, "buildView");
+        SortedView& v = views[view];
+        if (view == VIEW_METRIC) metricValues(viewMetric);
+        
+        for (int i = 0; i < studentCount; i++) {
+            v.order[i] = i;
+        }
+        std::sort(v.order, v.order + studentCount, [this, view](int a, int b) {
+            return viewLess(view, a, b);
+        });
+        for (int i = 0; i < studentCount; i++) {
+            v.position[v.order[i]] = i;
+        }
+        v.valid = true;
+    }
+    
+    // 某个学生的排序键变化后, 二分查找新位置并平移中间的行
+    void repositionInView(SortView view, int index) {
+        SortedView& v = views[view];
+        if (!v.valid) return;
+        
+        Profiler::ScopedTimer timer(Profiler::OP_SORT, "repositionInView");
+        int pos = v.position[index];
+        int newPos = pos;
+        if (pos > 0 && viewLess(view, index, v.order[pos - 1])) {
+            // 前移: 在 [0, pos) 中找第一个排在它之后的行
+            int lo = 0, hi = pos;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (viewLess(view, index, v.order[mid])) hi = mid;
+                else lo = mid + 1;
+            }
+            newPos = lo;
+            memmove(&v.order[newPos + 1], &v.order[newPos], (pos - newPos) * sizeof(int));
+        } else if (pos < studentCount - 1 && viewLess(view, v.order[pos + 1], index)) {
+            // 后移: 在 (pos, count) 中找最后一个排在它之前的行
+            int lo = pos + 1, hi = studentCount;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (viewLess(view, v.order[mid], index)) lo = mid + 1;
+                else hi = mid;
+            }
+            newPos = lo - 1;
+            memmove(&v.order[pos], &v.order[pos + 1], (newPos - pos) * sizeof(int));
+        }
+        v.order[newPos] = index;
+        
+        int first = pos < newPos ? pos : newPos;
+        int last = pos < newPos ? newPos : pos;
+        for (int i = first; i <= last; i++) {
+            v.position[v.order[i]] = i;
+        }
+    }
+    
+    // 数据整体变化后所有视图失效, 当前视图立即重建以保证 studentAt 可用
+    void invalidateViews() {
+        for (int i = 0; i < VIEW_COUNT; i++) {
+            views[i].valid = false;
+        }
+        if (activeView != VIEW_NONE) buildView(activeView);
+    }
+    
+public:
+    Student students[Config::MAX_STUDENTS];
+    CourseStats courseStats[Config::MAX_COURSES];
+    int studentCount;
+    int courseCount;
+    DerivedMetric metrics[Config::MAX_METRICS];
+    int metricCount;
+    unsigned long dataVersion;      // 学生数据每次变化时递增, 使派生列缓存失效
+    TextCodec::Encoding lastFileEncoding;   // 最近一次读取的文件编码
+    bool lastFileValid;                     // 最近一次读取的文件是否没有非法字符
+    
+    StudentManager() : activeView(VIEW_NONE), viewMetric(0), viewMetricAscending(false),
+                       studentCount(0), courseCount(0), metricCount(0), dataVersion(0),
+                       lastFileEncoding(TextCodec::ENCODING_ASCII), lastFileValid(true) {
+        memset(views, 0, sizeof(views));
+        memset(students, 0, sizeof(students));
+        memset(courseStats, 0, sizeof(courseStats));
+        memset(metrics, 0, sizeof(metrics));
+    }
+    
+    // 学生数据整体变化后调用, 派生列和排序视图都需重建
+    void invalidateDerived() {
+        dataVersion++;
+        invalidateViews();
+    }
+    
+    // 定义或更新派生指标, 返回其下标, -1表示已满
+    int defineMetric(const char* name, const MetricFormula& formula) {
+        int index = findMetric(name);
+        if (index < 0) {
+            if (metricCount >= Config::MAX_METRICS) return -1;
+            index = metricCount++;
+        }
+        
+        DerivedMetric& metric = metrics[index];
+        strncpy(metric.name, name, sizeof(metric.name) - 1);
+        metric.name[sizeof(metric.name) - 1] = '\0';
+        metric.formula = formula;
+        metric.cached = false;
+        if (index == viewMetric) {
+            views[VIEW_METRIC].valid = false;
+            if (activeView == VIEW_METRIC) buildView(VIEW_METRIC);
+        }
+        return index;
+    }
+    
+    int findMetric(const char* name) const {
+        for (int i = 0; i < metricCount; i++) {
+            if (strcmp(metrics[i].name, name) == 0) return i;
+        }
+        return -1;
+    }
+    
+    // 取派生列的全部值, 首次访问或数据变化后才重新计算
+    const float* metricValues(int index) {
+        DerivedMetric& metric = metrics[index];
+        if (!metric.cached || metric.cachedVersion != dataVersion) {
+            Profiler::ScopedTimer timer(Profiler::OP_STATS, "computeMetric");
+            Kernels::dispatchCourseCount(courseCount, [&](auto n) {
+                Kernels::computeMetric<decltype(n)::value>(students, studentCount, courseCount,
+                                                          metric, metric.values);
+            });
+            metric.cachedVersion = dataVersion;
+            metric.cached = true;
+        }
+        return metric.values;
+    }
+    
+    float metricValue(int index, int studentIndex) {
+        return metricValues(index)[studentIndex];
+    }
+    
+    // 按派生列筛选, 把 [minValue, maxValue] 内的学生下标写入 out, 返回个数
+    int filterByMetric(int index, float minValue, float maxValue, int* out) {
+        Profiler::ScopedTimer timer(Profiler::OP_SEARCH, "filterByMetric");
+        const float* values = metricValues(index);
+        int count = 0;
+        for (int i = 0; i < studentCount; i++) {
+            if (values[i] >= minValue && values[i] <= maxValue) out[count++] = i;
+        }
+        return count;
+    }
+    
+    // 计算所有学生的总分和平均分
+    void calculateStudentScores() {
+        Profiler::ScopedTimer timer(Profiler::OP_STATS, "calculateStudentScores");
+        // 整批只分派一次, 避免每个学生重复判断科目数
+        Kernels::dispatchCourseCount(courseCount, [&](auto n) {
+            Kernels::computeStudentScores<decltype(n)::value>(students, studentCount, courseCount);
+        });
+        invalidateDerived();
+    }
+    
+    // 计算各科目统计信息
+    void calculateCourseStats() {
+        Profiler::ScopedTimer timer(Profiler::OP_STATS, "calculateCourseStats");
+        Kernels::dispatchCourseCount(courseCount, [&](auto n) {
+            Kernels::computeCourseStats<decltype(n)::value>(students, studentCount, 
+                                                             courseStats, courseCount);
+        });
+    }
+    
+    // 修改单科成绩 - 总分类视图只移动该学生一人, 其余视图保持不变
+    bool setScore(int index, int course, float score) {
+        if (index < 0 || index >= studentCount || course < 0 || course >= courseCount) {
+            return false;
+        }
+        
+        Student& st = students[index];
+        st.scores[course] = score;
+        st.calculateScores(courseCount);
+        dataVersion++;
+        
+        repositionInView(VIEW_TOTAL_DESC, index);
+        repositionInView(VIEW_TOTAL_ASC, index);
+        views[VIEW_METRIC].valid = false;
+        if (activeView == VIEW_METRIC) buildView(VIEW_METRIC);
+        return true;
+    }
+    
+    // 按总分排序 - 切换到缓存的视图, 学生数据本身不移动
+    void sortByTotalScore(bool ascending) {
+        selectView(ascending ? VIEW_TOTAL_ASC : VIEW_TOTAL_DESC);
+    }
+    
+    // 按学号排序
+    void sortById() {
+        selectView(VIEW_ID);
+    }
+    
+    // 按姓名字典序排序
+    void sortByName() {
+        selectView(VIEW_NAME);
+    }
+    
+    // 按派生列排序
+    void sortByMetric(int index, bool ascending) {
+        if (viewMetric != index || viewMetricAscending != ascending) {
+            viewMetric = index;
+            viewMetricAscending = ascending;
+            views[VIEW_METRIC].valid = false;
+        }
+        selectView(VIEW_METRIC);
+    }
+    
+    void selectView(SortView view) {
+        if (!views[view].valid) buildView(view);
+        activeView = view;
+    }
+    
+    // 当前视图中第 row 行对应的学生下标
+    int studentAt(int row) const {
+        return activeView == VIEW_NONE ? row : views[activeView].order[row];
+    }
+    
+    // 按学号查找，返回索引，-1表示未找到
+    int findById(long id) const {
+        Profiler::ScopedTimer timer(Profiler::OP_SEARCH, "findById");
+        for (int i = 0; i < studentCount; i++) {
+            if (students[i].id == id) return i;
+        }
+        return -1;
+    }
+    
+    // 按姓名查找
+    int findByName(const char* name) const {
+        Profiler::ScopedTimer timer(Profiler::OP_SEARCH, "findByName");
+        for (int i = 0; i < studentCount; i++) {
+            if (strcmp(students[i].name, name) == 0) return i;
+        }
+        return -1;
+    }
+    
+    // 写入文件, 字段名和姓名按 encoding 编码写出
+    bool saveToFile(const char* filepath, 
+                    TextCodec::Encoding encoding = TextCodec::DEFAULT_FILE_ENCODING) const {
+        Profiler::ScopedTimer timer(Profiler::OP_SAVE, "saveToFile");
+        FILE* file = fopen(filepath, "w");
+        if (!file) return false;
+        
+        using namespace RosterText;
+        TextCodec::Encoding native = TextCodec::nativeEncoding();
+        std::string labels[5];
+        const char* utf8Labels[5] = {LABEL_NAME, LABEL_ID, LABEL_SCORES, LABEL_TOTAL, LABEL_AVERAGE};
+        for (int k = 0; k < 5; k++) {
+            TextCodec::transcode(utf8Labels[k], strlen(utf8Labels[k]), 
+                                 TextCodec::ENCODING_UTF8, encoding, labels[k]);
+        }
+        
+        std::string out;
+        std::string converted;
+        char buffer[64];
+        
+        TextCodec::transcode(LABEL_STUDENT_COUNT, strlen(LABEL_STUDENT_COUNT), 
+                             TextCodec::ENCODING_UTF8, encoding, converted);
+        sprintf(buffer, "%d\n", studentCount);
+        out += converted;
+        out += buffer;
+        TextCodec::transcode(LABEL_COURSE_COUNT, strlen(LABEL_COURSE_COUNT), 
+                             TextCodec::ENCODING_UTF8, encoding, converted);
+        sprintf(buffer, "%d\n", courseCount);
+        out += converted;
+        out += buffer;
+        
+        // 按当前视图顺序写出
+        for (int row = 0; row < studentCount; row++) {
+            const Student& st = students[studentAt(row)];
+            TextCodec::transcode(st.name, strlen(st.name), native, encoding, converted);
+            out += labels[0];
+            out += converted;
+            out += "\n";
+            out += labels[1];
+            sprintf(buffer, "%ld\n", st.id);
+            out += buffer;
+            out += labels[2];
+            for (int j = 0; j < courseCount; j++) {
+                sprintf(buffer, "%.2f ", st.scores[j]);
+                out += buffer;
+            }
+            out += "\n";
+            out += labels[3];
+            sprintf(buffer, "%.2f\n", st.totalScore);
+            out += buffer;
+            out += labels[4];
+            sprintf(buffer, "%.2f\n\n", st.avgScore);
+            out += buffer;
+        }
+        
+        bool success = fwrite(out.data(), 1, out.size(), file) == out.size();
+        success = (fclose(file) == 0) && success;
+        return success;
+    }
+    
+    // 从文件读取, 自动识别 GBK / UTF-8 并转换为本机编码
+    bool loadFromFile(const char* filepath) {
+        Profiler::ScopedTimer timer(Profiler::OP_LOAD, "loadFromFile");
+        FILE* file = fopen(filepath, "rb");
+        if (!file) return false;
+        
+        std::string raw;
+        char chunk[65536];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            raw.append(chunk, got);
+        }
+        fclose(file);
+        
+        const char* data = raw.data();
+        size_t size = raw.size();
+        if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+            data += 3;
+            size -= 3;
+            lastFileEncoding = TextCodec::ENCODING_UTF8;
+        } else {
+            lastFileEncoding = TextCodec::detect(data, size);
+        }
+        
+        TextCodec::Encoding native = TextCodec::nativeEncoding();
+        std::string text;
+        lastFileValid = TextCodec::transcode(data, size, lastFileEncoding, native, text);
+        
+        RosterText::FieldReader reader(text.c_str(), text.size(), native);
+        int count;
+        int courses;
+        if (!reader.nextField() || !reader.readInt(&count) || count < 0 || count > Config::MAX_STUDENTS) {
+            return false;
+        }
+        if (!reader.nextField() || !reader.readInt(&courses) || courses < 0 || courses > Config::MAX_COURSES) {
+            return false;
+        }
+        
+        studentCount = count;
+        courseCount = courses;
+        bool success = true;
+        for (int i = 0; i < count && success; i++) {
+            // 先清空, 避免上一份名单在未读取的科目上留下旧成绩
+            Student& st = students[i];
+            memset(&st, 0, sizeof(st));
+            success = reader.nextField() && reader.readToken(st.name, Config::MAX_NAME_LEN) &&
+                      reader.nextField() && reader.readLong(&st.id) &&
+                      reader.nextField();
+            for (int j = 0; j < courseCount && success; j++) {
+                success = reader.readFloat(&st.scores[j]);
+            }
+            success = success &&
+                      reader.nextField() && reader.readFloat(&st.totalScore) &&
+                      reader.nextField() && reader.readFloat(&st.avgScore);
+            
+            // 文件不完整时只保留已完整读取的学生
+            if (!success) studentCount = i;
+        }
+        invalidateDerived();
+        return success;
+    }
+};
+
+// ==================== 分组统计 ====================
+
+// 单个分组的聚合结果, 分组键为学号前缀 (学号 / divisor)
+struct GroupStats {
+    long key;
+    int count;
+    double totalSum;        // 求和用 double, 大分组下 float 累加误差明显且依赖分块方式
+    float totalMin;
+    float totalMax;
+    double courseSum[Config::MAX_COURSES];
+    int gradeCount[5];      // 按学生平均分统计的 A-E 人数
+    
+    float avgTotal() const {
+        return count > 0 ? (float)(totalSum / count) : 0;
+    }
+    
+    float courseAvg(int course) const {
+        return count > 0 ? (float)(courseSum[course] / count) : 0;
+    }
+};
+
+// 分组结果的排序依据
+enum GroupSortKey {
+    GROUP_SORT_KEY = 0,
+    GROUP_SORT_COUNT,
+    GROUP_SORT_AVG_TOTAL,
+    GROUP_SORT_MIN_TOTAL,
+    GROUP_SORT_MAX_TOTAL,
+    GROUP_SORT_COUNT_KEYS
+};
+
+// 哈希聚合 - 开放寻址表按分组键累加, 大数据量时各线程先各自聚合再合并
+class GroupAggregator {
+private:
+    // 线性探测哈希表, slots 存放 groups 的下标, -1 表示空
+    struct HashTable {
+        std::vector<int> slots;
+        std::vector<GroupStats> groups;
+        size_t mask;
+        
+        explicit HashTable(int expectedGroups) {
+            size_t capacity = 16;
+            while (capacity < (size_t)expectedGroups * 2) capacity <<= 1;
+            slots.assign(capacity, -1);
+            mask = capacity - 1;
+        }
+        
+        GroupStats& findOrInsert(long key) {
+            size_t pos = hashKey(key) & mask;
+            while (slots[pos] >= 0) {
+                GroupStats& group = groups[slots[pos]];
+                if (group.key == key) return group;
+                pos = (pos + 1) & mask;
+            }
+            
+            GroupStats group;
+            memset(&group, 0, sizeof(group));
+            group.key = key;
+            slots[pos] = (int)groups.size();
+            groups.push_back(group);
+            
+            // 装载因子超过一半时扩容
+            if (groups.size() * 2 > slots.size()) {
+                rehash(slots.size() * 2);
+                return groups[lookup(key)];
+            }
+            return groups.back();
+        }
+        
+        int lookup(long key) const {
+            size_t pos = hashKey(key) & mask;
+            while (slots[pos] >= 0 && groups[slots[pos]].key != key) {
+                pos = (pos + 1) & mask;
+            }
+            return slots[pos];
+        }
+        
+        void rehash(size_t capacity) {
+            slots.assign(capacity, -1);
+            mask = capacity - 1;
+            for (size_t i = 0; i < groups.size(); i++) {
+                size_t pos = hashKey(groups[i].key) & mask;
+                while (slots[pos] >= 0) pos = (pos + 1) & mask;
+                slots[pos] = (int)i;
+            }
+        }
+        
+        static size_t hashKey(long key) {
+            unsigned long long h = (unsigned long long)key * 0x9E3779B97F4A7C15ULL;
+            return (size_t)(h ^ (h >> 32));
+        }
+    };
+    
+    static void accumulate(HashTable& table, const Student* students, int begin, int end,
+                           int courseCount, long divisor) {
+        for (int i = begin; i < end; i++) {
+            const Student& st = students[i];
+            GroupStats& group = table.findOrInsert(st.id / divisor);
+            
+            if (group.count == 0) {
+                group.totalMin = st.totalScore;
+                group.totalMax = st.totalScore;
+            } else {
+                if (st.totalScore < group.totalMin) group.totalMin = st.totalScore;
+                if (st.totalScore > group.totalMax) group.totalMax = st.totalScore;
+            }
+            group.count++;
+            group.totalSum += st.totalScore;
+            for (int j = 0; j < courseCount; j++) {
+                group.courseSum[j] += st.scores[j];
+            }
+            group.gradeCount[Kernels::gradeIndex(st.avgScore)]++;
+        }
+    }
+    
+    static void merge(GroupStats& dst, const GroupStats& src, int courseCount) {
+        if (src.count == 0) return;
+        if (dst.count == 0) {
+            dst.totalMin = src.totalMin;
+            dst.totalMax = src.totalMax;
+        } else {
+            if (src.totalMin < dst.totalMin) dst.totalMin = src.totalMin;
+            if (src.totalMax > dst.totalMax) dst.totalMax = src.totalMax;
+        }
+        dst.count += src.count;
+        dst.totalSum += src.totalSum;
+        for (int j = 0; j < courseCount; j++) {
+            dst.courseSum[j] += src.courseSum[j];
+        }
+        for (int g = 0; g < 5; g++) {
+            dst.gradeCount[g] += src.gradeCount[g];
+        }
+    }
+    
+public:
+    // 按学号前缀分组聚合, divisor 为 100 时学号 10123 归入分组 101
+    static void aggregateByIdPrefix(const StudentManager& mgr, long divisor,
+                                    std::vector<GroupStats>& out) {
+        int threadCount = 1;
+        if (mgr.studentCount >= Config::PARALLEL_THRESHOLD) {
+            threadCount = (int)std::thread::hardware_concurrency();
+            if (threadCount < 1) threadCount = 1;
+            if (threadCount > Config::MAX_WORKER_THREADS) threadCount = Config::MAX_WORKER_THREADS;
+        }
+        aggregateByIdPrefix(mgr.students, mgr.studentCount, mgr.courseCount, divisor, out, threadCount);
+    }
+    
+    // 直接作用于学生数组, 由调用方指定线程数 (基准测试用它对比单线程与多线程)
+    static void aggregateByIdPrefix(const Student* students, int studentCount, int courseCount,
+                                    long divisor, std::vector<GroupStats>& out, int threadCount) {
+        Profiler::ScopedTimer timer(Profiler::OP_STATS, "aggregateByIdPrefix");
+        out.clear();
+        if (divisor <= 0) divisor = 1;
+        if (threadCount < 1) threadCount = 1;
+        
+        int chunk = (studentCount + threadCount - 1) / threadCount;
+        std::vector<HashTable> partials(threadCount, HashTable(chunk > 0 ? chunk : 1));
+        
+        if (threadCount == 1) {
+            accumulate(partials[0], students, 0, studentCount, courseCount, divisor);
+        } else {
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threadCount; t++) {
+                int begin = t * chunk;
+                int end = begin + chunk < studentCount ? begin + chunk : studentCount;
+                if (begin >= end) break;
+                workers.emplace_back([&partials, students, courseCount, t, begin, end, divisor]() {
+                    accumulate(partials[t], students, begin, end, courseCount, divisor);
+                });
+            }
+            for (size_t t = 0; t < workers.size(); t++) {
+                workers[t].join();
+            }
+        }
+        
+        // 把各线程的局部结果合并进第一张表
+        HashTable& result = partials[0];
+        for (int t = 1; t < threadCount; t++) {
+            for (size_t g = 0; g < partials[t].groups.size(); g++) {
+                const GroupStats& src = partials[t].groups[g];
+                merge(result.findOrInsert(src.key), src, courseCount);
+            }
+        }
+        out.swap(result.groups);
+    }
+    
+    static void sortGroups(std::vector<GroupStats>& groups, GroupSortKey sortKey, bool ascending) {
+        Profiler::ScopedTimer timer(Profiler::OP_SORT, "sortGroups");
+        auto keyOf = [sortKey](const GroupStats& g) -> double {
+            switch (sortKey) {
+                case GROUP_SORT_COUNT:     return g.count;
+                case GROUP_SORT_AVG_TOTAL: return g.avgTotal();
+                case GROUP_SORT_MIN_TOTAL: return g.totalMin;
+                case GROUP_SORT_MAX_TOTAL: return g.totalMax;
+                default:                   return (double)g.key;
+            }
+        };
+        std::sort(groups.begin(), groups.end(), [&](const GroupStats& a, const GroupStats& b) {
+            double ka = keyOf(a);
+            double kb = keyOf(b);
+            if (ka != kb) return ascending ? ka < kb : ka > kb;
+            return a.key < b.key;
+        });
+    }
+};
+
+// ==================== 名单对比 ====================
+
+enum ChangeType {
+    CHANGE_ADDED = 0,
+    CHANGE_REMOVED,
+    CHANGE_MODIFIED
+};
+
+// 两份名单间单个学号的差异, 下标指向各自 StudentManager 中的位置, -1 表示不存在
+struct StudentChange {
+    ChangeType type;
+    long id;
+    int oldIndex;
+    int newIndex;
+    bool nameChanged;
+    float delta[Config::MAX_COURSES];   // 新成绩 - 旧成绩
+};
+
+// 按学号做排序-归并连接, 大数据量时两侧并行排序并按学号区间分段归并
+class RosterDiff {
+private:
+    // 学号相同时依次按姓名、各科成绩、原下标排序, 两份相同的名单即使含重复学号也会一一配对
+    static void sortIndicesById(const Student* students, int studentCount, int courseCount, 
+                                std::vector<int>& order) {
+        order.resize(studentCount);
+        for (int i = 0; i < studentCount; i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [students, courseCount](int a, int b) {
+            const Student& sa = students[a];
+            const Student& sb = students[b];
+            if (sa.id != sb.id) return sa.id < sb.id;
+            int cmp = strcmp(sa.name, sb.name);
+            if (cmp != 0) return cmp < 0;
+            for (int c = 0; c < courseCount; c++) {
+                // NaN 排在所有数值之后, 保证比较关系仍是严格弱序
+                bool nanA = sa.scores[c] != sa.scores[c];
+                bool nanB = sb.scores[c] != sb.scores[c];
+                if (nanA != nanB) return nanB;
+                if (!nanA && sa.scores[c] != sb.scores[c]) return sa.scores[c] < sb.scores[c];
+            }
+            return a < b;
+        });
+    }
+    
+    static void mergeRange(const Student* oldStudents, const Student* newStudents,
+                           const std::vector<int>& oldOrder, const std::vector<int>& newOrder,
+                           size_t oldBegin, size_t oldEnd, size_t newBegin, size_t newEnd,
+                           int courseCount, std::vector<StudentChange>& out) {
+        size_t i = oldBegin;
+        size_t j = newBegin;
+        while (i < oldEnd || j < newEnd) {
+            StudentChange change;
+            memset(&change, 0, sizeof(change));
+            change.oldIndex = -1;
+            change.newIndex = -1;
+            
+            long oldId = i < oldEnd ? oldStudents[oldOrder[i]].id : 0;
+            long newId = j < newEnd ? newStudents[newOrder[j]].id : 0;
+            
+            if (j >= newEnd || (i < oldEnd && oldId < newId)) {
+                change.type = CHANGE_REMOVED;
+                change.id = oldId;
+                change.oldIndex = oldOrder[i++];
+                out.push_back(change);
+            } else if (i >= oldEnd || newId < oldId) {
+                change.type = CHANGE_ADDED;
+                change.id = newId;
+                change.newIndex = newOrder[j++];
+                out.push_back(change);
+            } else {
+                const Student& oldSt = oldStudents[oldOrder[i]];
+                const Student& newSt = newStudents[newOrder[j]];
+                change.nameChanged = strcmp(oldSt.name, newSt.name) != 0;
+                if (change.nameChanged || !Kernels::scoresEqual(oldSt.scores, newSt.scores, courseCount)) {
+                    change.type = CHANGE_MODIFIED;
+                    change.id = oldId;
+                    change.oldIndex = oldOrder[i];
+                    change.newIndex = newOrder[j];
+                    for (int c = 0; c < courseCount; c++) {
+                        bool bothNan = oldSt.scores[c] != oldSt.scores[c] && newSt.scores[c] != newSt.scores[c];
+                        change.delta[c] = bothNan ? 0 : newSt.scores[c] - oldSt.scores[c];
+                    }
+                    out.push_back(change);
+                }
+                i++;
+                j++;
+            }
+        }
+    }
+    
+public:
+    // 结果按学号升序排列; 两份名单科目数量不同时无法逐科对比, 返回 false
+    static bool diff(const StudentManager& oldMgr, const StudentManager& newMgr,
+                     std::vector<StudentChange>& out) {
+        out.clear();
+        if (oldMgr.courseCount != newMgr.courseCount) return false;
+        
+        int threadCount = 1;
+        if (oldMgr.studentCount + newMgr.studentCount >= Config::PARALLEL_THRESHOLD) {
+            threadCount = (int)std::thread::hardware_concurrency();
+            if (threadCount < 1) threadCount = 1;
+            if (threadCount > Config::MAX_WORKER_THREADS) threadCount = Config::MAX_WORKER_THREADS;
+        }
+        diff(oldMgr.students, oldMgr.studentCount, newMgr.students, newMgr.studentCount,
+             oldMgr.courseCount, out, threadCount);
+        return true;
+    }
+    
+    // 直接作用于学生数组, 由调用方指定线程数 (基准测试用它对比单线程与多线程)
+    static void diff(const Student* oldStudents, int oldCount, const Student* newStudents, int newCount,
+                     int courseCount, std::vector<StudentChange>& out, int threadCount) {
+        Profiler::ScopedTimer timer(Profiler::OP_SEARCH, "diffRosters");
+        out.clear();
+        if (threadCount < 1) threadCount = 1;
+        
+        std::vector<int> oldOrder;
+        std::vector<int> newOrder;
+        if (threadCount > 1) {
+            std::thread worker([&]() { sortIndicesById(newStudents, newCount, courseCount, newOrder); });
+            sortIndicesById(oldStudents, oldCount, courseCount, oldOrder);
+            worker.join();
+        } else {
+            sortIndicesById(oldStudents, oldCount, courseCount, oldOrder);
+            sortIndicesById(newStudents, newCount, courseCount, newOrder);
+        }
+        
+        if (threadCount == 1 || oldOrder.empty()) {
+            mergeRange(oldStudents, newStudents, oldOrder, newOrder, 0, oldOrder.size(), 
+                       0, newOrder.size(), courseCount, out);
+            return;
+        }
+        
+        // 以旧名单的等分点学号切段, 新名单用二分找到对应边界, 同一学号不会跨段
+        std::vector<size_t> oldCuts(threadCount + 1);
+        std::vector<size_t> newCuts(threadCount + 1);
+        oldCuts[0] = 0;
+        newCuts[0] = 0;
+        oldCuts[threadCount] = oldOrder.size();
+        newCuts[threadCount] = newOrder.size();
+        for (int t = 1; t < threadCount; t++) {
+            long splitId = oldStudents[oldOrder[oldOrder.size() * t / threadCount]].id;
+            auto byId = [](const Student* students) {
+                return [students](int index, long id) { return students[index].id < id; };
+            };
+            oldCuts[t] = std::lower_bound(oldOrder.begin(), oldOrder.end(), splitId, byId(oldStudents)) - oldOrder.begin();
+            newCuts[t] = std::lower_bound(newOrder.begin(), newOrder.end(), splitId, byId(newStudents)) - newOrder.begin();
+        }
+        
+        std::vector<std::vector<StudentChange>> partials(threadCount);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; t++) {
+            workers.emplace_back([&, t]() {
+                mergeRange(oldStudents, newStudents, oldOrder, newOrder, oldCuts[t], oldCuts[t + 1],
+                           newCuts[t], newCuts[t + 1], courseCount, partials[t]);
+            });
+        }
+        for (size_t t = 0; t < workers.size(); t++) {
+            workers[t].join();
+        }
+        for (int t = 0; t < threadCount; t++) {
+            out.insert(out.end(), partials[t].begin(), partials[t].end());
+        }
+    }
+    
+    // 把差异写成编辑批次, 每行一条: ADD/DEL/NAME/SET
+    static bool writeEditBatch(const char* filepath, const std::vector<StudentChange>& changes,
+                               const StudentManager& newMgr) {
+        Profiler::ScopedTimer timer(Profiler::OP_SAVE, "writeEditBatch");
+        FILE* file = fopen(filepath, "w");
+        if (!file) return false;
+        
+        for (size_t i = 0; i < changes.size(); i++) {
+            const StudentChange& c = changes[i];
+            if (c.type == CHANGE_ADDED) {
+                const Student& st = newMgr.students[c.newIndex];
+                fprintf(file, "ADD %ld %s", st.id, st.name);
+                for (int j = 0; j < newMgr.courseCount; j++) {
+                    fprintf(file, " %.2f", st.scores[j]);
+                }
+                fprintf(file, "\n");
+            } else if (c.type == CHANGE_REMOVED) {
+                fprintf(file, "DEL %ld\n", c.id);
+            } else {
+                if (c.nameChanged) {
+                    fprintf(file, "NAME %ld %s\n", c.id, newMgr.students[c.newIndex].name);
+                }
+                for (int j = 0; j < newMgr.courseCount; j++) {
+                    if (c.delta[j] != 0) {
+                        fprintf(file, "SET %ld %d %.2f\n", c.id, j + 1, 
+                                newMgr.students[c.newIndex].scores[j]);
+                    }
+                }
+            }
+        }
+        
+        bool success = !ferror(file);
+        success = (fclose(file) == 0) && success;
+        return success;
+    }
+};
+
+// ==================== 索引文件 ====================
+// 二进制名单文件, 按页 (PAGE_SIZE 字节) 组织:
+//   第 0 页      文件头
+//   数据页       按学号升序的定长记录
+//   学号索引     静态 B+ 树, 内部节点保存各子页的首个学号
+//   姓名条目页   按 (姓名, 记录号) 排序的二级索引
+//   姓名索引     静态 B+ 树, 内部节点保存各子页的首个姓名
+// 查询时从根节点逐层向下, 只读取路径上的几页, 页面经有界 LRU 缓存
+
+namespace IndexFile {
+    constexpr int PAGE_SIZE = 4096;
+    constexpr int MAX_LEVELS = 8;
+    constexpr int VERSION = 1;
+    static const char MAGIC[8] = {'S', 'I', 'M', 'S', 'I', 'D', 'X', '1'};
+    
+    struct Record {
+        long long id;
+        char name[Config::MAX_NAME_LEN];
+        float scores[Config::MAX_COURSES];
+        float totalScore;
+        float avgScore;
+    };
+    
+    struct NameKey {
+        char name[Config::MAX_NAME_LEN];
+    };
+    
+    struct NameEntry {
+        char name[Config::MAX_NAME_LEN];
+        int recordNo;
+    };
+    
+    // 一棵静态 B+ 树各层的位置, 第 0 层为叶子页, 最高层只有一个根节点
+    struct TreeInfo {
+        int levels;
+        int levelStart[MAX_LEVELS];     // 该层首页页号
+        int levelCount[MAX_LEVELS];     // 该层页数
+    };
+    
+    struct Header {
+        char magic[8];
+        int version;
+        int pageSize;
+        int courseCount;
+        int studentCount;
+        int nameEntryCount;
+        TreeInfo idTree;
+        TreeInfo nameTree;
+    };
+    
+    constexpr int RECORDS_PER_PAGE = PAGE_SIZE / sizeof(Record);
+    constexpr int NAME_ENTRIES_PER_PAGE = PAGE_SIZE / sizeof(NameEntry);
+    constexpr int ID_KEYS_PER_PAGE = PAGE_SIZE / sizeof(long long);
+    constexpr int NAME_KEYS_PER_PAGE = PAGE_SIZE / sizeof(NameKey);
+    static_assert(sizeof(Header) <= PAGE_SIZE, "索引文件头超过一页");
+    
+    inline bool idLess(long long a, long long b) {
+        return a < b;
+    }
+    
+    inline bool nameLess(const NameKey& a, const NameKey& b) {
+        return strncmp(a.name, b.name, Config::MAX_NAME_LEN) < 0;
+    }
+    
+    // 超过 2GB 的文件需要 64 位偏移
+    inline bool seekPage(FILE* file, int page) {
+        long long offset = (long long)page * PAGE_SIZE;
+#ifdef _WIN32
+        return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+        return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+    }
+    
+    // 文件包含的完整页数, 失败时返回 -1
+    inline long long pageCountOf(FILE* file) {
+#ifdef _WIN32
+        if (_fseeki64(file, 0, SEEK_END) != 0) return -1;
+        long long size = _ftelli64(file);
+#else
+        if (fseeko(file, 0, SEEK_END) != 0) return -1;
+        long long size = (long long)ftello(file);
+#endif
+        return size < 0 ? -1 : size / PAGE_SIZE;
+    }
+    
+    // 检查从磁盘读出的树结构: 层数在 1..MAX_LEVELS, 每层页数与下一层相符, 且都在文件范围内
+    inline bool validTree(const TreeInfo& tree, int entryCount, int entriesPerPage, 
+                          int keysPerPage, long long filePages) {
+        if (tree.levels < 1 || tree.levels > MAX_LEVELS || entryCount < 0) return false;
+        long long expected = ((long long)entryCount + entriesPerPage - 1) / entriesPerPage;
+        for (int level = 0; level < tree.levels; level++) {
+            if (tree.levelCount[level] != expected || tree.levelStart[level] < 1 ||
+                (long long)tree.levelStart[level] + tree.levelCount[level] > filePages) {
+                return false;
+            }
+            expected = ((long long)expected + keysPerPage - 1) / keysPerPage;
+        }
+        // 最高层只能有一个根节点 (空树时为 0 页)
+        return tree.levelCount[tree.levels - 1] <= 1;
+    }
+    
+    // 有界 LRU 页缓存, 容量固定, 页数少时线性查找即可
+    class PageCache {
+    private:
+        struct Frame {
+            int page;
+            unsigned long long lastUse;
+            char data[PAGE_SIZE];
+        };
+        
+        std::vector<Frame> frames;
+        unsigned long long clock;
+        
+    public:
+        unsigned long long hits;
+        unsigned long long misses;
+        
+        explicit PageCache(int capacity) : frames(capacity), clock(0), hits(0), misses(0) {
+            clear();
+        }
+        
+        void clear() {
+            for (size_t i = 0; i < frames.size(); i++) {
+                frames[i].page = -1;
+                frames[i].lastUse = 0;
+            }
+        }
+        
+        // 返回页内容, 读取失败时返回 nullptr
+        const char* fetch(FILE* file, int page) {
+            Frame* victim = &frames[0];
+            for (size_t i = 0; i < frames.size(); i++) {
+                if (frames[i].page == page) {
+                    frames[i].lastUse = ++clock;
+                    hits++;
+                    return frames[i].data;
+                }
+                if (frames[i].lastUse < victim->lastUse) victim = &frames[i];
+            }
+            
+            misses++;
+            if (!seekPage(file, page) || fread(victim->data, 1, PAGE_SIZE, file) != (size_t)PAGE_SIZE) {
+                victim->page = -1;
+                victim->lastUse = 0;
+                return nullptr;
+            }
+            victim->page = page;
+            victim->lastUse = ++clock;
+            return victim->data;
+        }
+    };
+    
+    // 写出一层内部节点, 每个节点保存其子页的首键
+    template <typename Key>
+    inline bool writeTree(FILE* file, int& nextPage, std::vector<Key> firstKeys,
+                          int leafStart, int keysPerPage, TreeInfo& tree) {
+        tree.levels = 1;
+        tree.levelStart[0] = leafStart;
+        tree.levelCount[0] = (int)firstKeys.size();
+        
+        std::vector<char> page(PAGE_SIZE);
+        while (firstKeys.size() > 1) {
+            if (tree.levels >= MAX_LEVELS) return false;
+            
+            int nodeCount = (int)((firstKeys.size() + keysPerPage - 1) / keysPerPage);
+            tree.levelStart[tree.levels] = nextPage;
+            tree.levelCount[tree.levels] = nodeCount;
+            tree.levels++;
+            
+            std::vector<Key> parentKeys;
+            for (int node = 0; node < nodeCount; node++) {
+                size_t begin = (size_t)node * keysPerPage;
+                size_t count = firstKeys.size() - begin < (size_t)keysPerPage ? 
+                    firstKeys.size() - begin : (size_t)keysPerPage;
+                memset(page.data(), 0, PAGE_SIZE);
+                memcpy(page.data(), &firstKeys[begin], count * sizeof(Key));
+                if (fwrite(page.data(), 1, PAGE_SIZE, file) != (size_t)PAGE_SIZE) return false;
+                parentKeys.push_back(firstKeys[begin]);
+                nextPage++;
+            }
+            firstKeys.swap(parentKeys);
+        }
+        return true;
+    }
+}
+
+// 索引名单文件 - 生成, 以及不加载整个文件的点查询和区间查询
+class IndexedRoster {
+private:
+    FILE* file;
+    IndexFile::Header header;
+    IndexFile::PageCache cache;
+    
+    static void toRecord(const Student& st, IndexFile::Record& rec) {
+        memset(&rec, 0, sizeof(rec));
+        rec.id = st.id;
+        memcpy(rec.name, st.name, sizeof(rec.name));
+        memcpy(rec.scores, st.scores, sizeof(rec.scores));
+        rec.totalScore = st.totalScore;
+        rec.avgScore = st.avgScore;
+    }
+    
+    static void toStudent(const IndexFile::Record& rec, Student& st) {
+        memset(&st, 0, sizeof(st));
+        st.id = (long)rec.id;
+        memcpy(st.name, rec.name, sizeof(st.name));
+        st.name[sizeof(st.name) - 1] = '\0';
+        memcpy(st.scores, rec.scores, sizeof(st.scores));
+        st.totalScore = rec.totalScore;
+        st.avgScore = rec.avgScore;
+    }
+    
+    // 从根向下, 返回可能包含 target 的最左叶子页序号, -1 表示读取失败
+    template <typename Key, typename Less>
+    int descend(const IndexFile::TreeInfo& tree, int keysPerPage, const Key& target, Less less) {
+        int node = 0;
+        for (int level = tree.levels - 1; level >= 1; level--) {
+            const char* page = cache.fetch(file, tree.levelStart[level] + node);
+            if (!page) return -1;
+            
+            int childBegin = node * keysPerPage;
+            int childCount = tree.levelCount[level - 1] - childBegin;
+            if (childCount > keysPerPage) childCount = keysPerPage;
+            
+            // 首个不小于 target 的键的前一个子页, 保证重复键时不会跳过
+            const Key* keys = (const Key*)page;
+            int lo = 0, hi = childCount;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (less(keys[mid], target)) lo = mid + 1;
+                else hi = mid;
+            }
+            node = childBegin + (lo > 0 ? lo - 1 : 0);
+        }
+        return node;
+    }
+    
+    bool readRecord(int recordNo, Student& out) {
+        if (recordNo < 0 || recordNo >= header.studentCount) return false;
+        int leaf = recordNo / IndexFile::RECORDS_PER_PAGE;
+        const char* page = cache.fetch(file, header.idTree.levelStart[0] + leaf);
+        if (!page) return false;
+        const IndexFile::Record* recs = (const IndexFile::Record*)page;
+        toStudent(recs[recordNo % IndexFile::RECORDS_PER_PAGE], out);
+        return true;
+    }
+    
+public:
+    explicit IndexedRoster(int cachePages = Config::INDEX_CACHE_PAGES) 
+        : file(nullptr), cache(cachePages) {
+        memset(&header, 0, sizeof(header));
+    }
+    
+    ~IndexedRoster() {
+        close();
+    }
+    
+    IndexedRoster(const IndexedRoster&) = delete;
+    IndexedRoster& operator=(const IndexedRoster&) = delete;
+    
+    static bool write(const StudentManager& mgr, const char* filepath) {
+        return write(mgr.students, mgr.studentCount, mgr.courseCount, filepath);
+    }
+    
+    // 按学号排序写出数据页并建立两棵索引树; 直接接收学生数组, 名单规模不受 MAX_STUDENTS 限制
+    static bool write(const Student* students, int studentCount, int courseCount, const char* filepath) {
+        Profiler::ScopedTimer timer(Profiler::OP_SAVE, "writeIndexedRoster");
+        using namespace IndexFile;
+        
+        std::vector<int> order(studentCount);
+        for (int i = 0; i < studentCount; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [students](int a, int b) {
+            return students[a].id < students[b].id;
+        });
+        
+        FILE* out = fopen(filepath, "wb");
+        if (!out) return false;
+        
+        Header hdr;
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, MAGIC, sizeof(hdr.magic));
+        hdr.version = VERSION;
+        hdr.pageSize = PAGE_SIZE;
+        hdr.courseCount = courseCount;
+        hdr.studentCount = studentCount;
+        hdr.nameEntryCount = studentCount;
+        
+        std::vector<char> page(PAGE_SIZE, 0);
+        bool ok = fwrite(page.data(), 1, PAGE_SIZE, out) == (size_t)PAGE_SIZE;
+        int nextPage = 1;
+        
+        // 数据页, 同时记下每页首个学号
+        int dataStart = nextPage;
+        std::vector<long long> firstIds;
+        for (int begin = 0; ok && begin < studentCount; begin += RECORDS_PER_PAGE) {
+            memset(page.data(), 0, PAGE_SIZE);
+            Record* recs = (Record*)page.data();
+            for (int k = 0; k < RECORDS_PER_PAGE && begin + k < studentCount; k++) {
+                toRecord(students[order[begin + k]], recs[k]);
+            }
+            firstIds.push_back(recs[0].id);
+            ok = fwrite(page.data(), 1, PAGE_SIZE, out) == (size_t)PAGE_SIZE;
+            nextPage++;
+        }
+        ok = ok && writeTree(out, nextPage, firstIds, dataStart, ID_KEYS_PER_PAGE, hdr.idTree);
+        
+        // 姓名条目页, 记录号即数据页中的位置
+        std::vector<NameEntry> entries(studentCount);
+        for (int r = 0; r < studentCount; r++) {
+            memset(&entries[r], 0, sizeof(NameEntry));
+            memcpy(entries[r].name, students[order[r]].name, Config::MAX_NAME_LEN);
+            entries[r].recordNo = r;
+        }
+        std::sort(entries.begin(), entries.end(), [](const NameEntry& a, const NameEntry& b) {
+            int cmp = strncmp(a.name, b.name, Config::MAX_NAME_LEN);
+            return cmp != 0 ? cmp < 0 : a.recordNo < b.recordNo;
+        });
+        
+        int nameStart = nextPage;
+        std::vector<NameKey> firstNames;
+        for (int begin = 0; ok && begin < studentCount; begin += NAME_ENTRIES_PER_PAGE) {
+            int count = studentCount - begin < NAME_ENTRIES_PER_PAGE ? 
+                studentCount - begin : NAME_ENTRIES_PER_PAGE;
+            memset(page.data(), 0, PAGE_SIZE);
+            memcpy(page.data(), &entries[begin], count * sizeof(NameEntry));
+            
+            NameKey key;
+            memcpy(key.name, entries[begin].name, sizeof(key.name));
+            firstNames.push_back(key);
+            ok = fwrite(page.data(), 1, PAGE_SIZE, out) == (size_t)PAGE_SIZE;
+            nextPage++;
+        }
+        ok = ok && writeTree(out, nextPage, firstNames, nameStart, NAME_KEYS_PER_PAGE, hdr.nameTree);
+        
+        // 最后回填文件头
+        memset(page.data(), 0, PAGE_SIZE);
+        memcpy(page.data(), &hdr, sizeof(hdr));
+        ok = ok && seekPage(out, 0) && fwrite(page.data(), 1, PAGE_SIZE, out) == (size_t)PAGE_SIZE;
+        
+        ok = (fclose(out) == 0) && ok;
+        return ok;
+    }
+    
+    bool open(const char* filepath) {
+        close();
+        file = fopen(filepath, "rb");
+        if (!file) return false;
+        
+        const char* page = cache.fetch(file, 0);
+        if (page) memcpy(&header, page, sizeof(header));
+        if (!page || memcmp(header.magic, IndexFile::MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != IndexFile::VERSION || header.pageSize != IndexFile::PAGE_SIZE) {
+            close();
+            return false;
+        }
+        
+        // 文件头来自磁盘, 截断或损坏时不能信任其中的层数和页号
+        long long filePages = IndexFile::pageCountOf(file);
+        if (filePages < 0 || header.courseCount < 0 || header.courseCount > Config::MAX_COURSES ||
+            header.nameEntryCount != header.studentCount ||
+            !IndexFile::validTree(header.idTree, header.studentCount, IndexFile::RECORDS_PER_PAGE,
+                                  IndexFile::ID_KEYS_PER_PAGE, filePages) ||
+            !IndexFile::validTree(header.nameTree, header.nameEntryCount, IndexFile::NAME_ENTRIES_PER_PAGE,
+                                  IndexFile::NAME_KEYS_PER_PAGE, filePages)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+    
+    void close() {
+        if (file) {
+            fclose(file);
+            file = nullptr;
+        }
+        cache.clear();
+        memset(&header, 0, sizeof(header));
+    }
+    
+    int courseCount() const {
+        return header.courseCount;
+    }
+    
+    const IndexFile::PageCache& pageCache() const {
+        return cache;
+    }
+    
+    // 学号区间查询 [minId, maxId], 最多返回 maxResults 条
+    int findByIdRange(long minId, long maxId, std::vector<Student>& out, int maxResults) {
+        Profiler::ScopedTimer timer(Profiler::OP_SEARCH, "indexedFindByIdRange");
+        out.clear();
+        if (!file || header.studentCount == 0) return 0;
+        
+        const IndexFile::TreeInfo& tree = header.idTree;
+        int leaf = descend(tree, IndexFile::ID_KEYS_PER_PAGE, (long long)minId, IndexFile::idLess);
+        if (leaf < 0) return 0;
+        
+        for (; leaf < tree.levelCount[0]; leaf++) {
+            const char* page = cache.fetch(file, tree.levelStart[0] + leaf);
+            if (!page) break;
+            
+            const IndexFile::Record* recs = (const IndexFile::Record*)page;
+            int begin = leaf * IndexFile::RECORDS_PER_PAGE;
+            for (int k = 0; k < IndexFile::RECORDS_PER_PAGE && begin + k < header.studentCount; k++) {
+                if (recs[k].id < minId) continue;
+                if (recs[k].id > maxId || (int)out.size() >= maxResults) return (int)out.size();
+                Student st;
+                toStudent(recs[k], st);
+                out.push_back(st);
+            }
+        }
+        return (int)out.size();
+    }
+    
+    bool findById(long id, Student& out) {
+        std::vector<Student> result;
+        if (findByIdRange(id, id, result, 1) == 0) return false;
+        out = result[0];
+        return true;
+    }
+    
+    // 姓名精确查询, 同名学生全部返回
+    int findByName(const char* name, std::vector<Student>& out, int maxResults) {
+        Profiler::ScopedTimer timer(Profiler::OP_SEARCH, "indexedFindByName");
+        out.clear();
+        if (!file || header.nameEntryCount == 0) return 0;
+        
+        IndexFile::NameKey target;
+        memset(&target, 0, sizeof(target));
+        strncpy(target.name, name, sizeof(target.name) - 1);
+        
+        const IndexFile::TreeInfo& tree = header.nameTree;
+        int leaf = descend(tree, IndexFile::NAME_KEYS_PER_PAGE, target, IndexFile::nameLess);
+        if (leaf < 0) return 0;
+        
+        for (; leaf < tree.levelCount[0]; leaf++) {
+            const char* page = cache.fetch(file, tree.levelStart[0] + leaf);
+            if (!page) break;
+            
+            // 先拷出本页命中的记录号, 读记录可能会换出当前页
+            std::vector<int> recordNos;
+            bool passed = false;
+            const IndexFile::NameEntry* entries = (const IndexFile::NameEntry*)page;
+            int begin = leaf * IndexFile::NAME_ENTRIES_PER_PAGE;
+            for (int k = 0; k < IndexFile::NAME_ENTRIES_PER_PAGE && begin + k < header.nameEntryCount; k++) {
+                int cmp = strncmp(entries[k].name, target.name, Config::MAX_NAME_LEN);
+                if (cmp < 0) continue;
+                if (cmp > 0) {
+                    passed = true;
+                    break;
+                }
+                recordNos.push_back(entries[k].recordNo);
+            }
+            
+            for (size_t r = 0; r < recordNos.size() && (int)out.size() < maxResults; r++) {
+                Student st;
+                if (readRecord(recordNos[r], st)) out.push_back(st);
+            }
+            if (passed || (int)out.size() >= maxResults) break;
+        }
+        return (int)out.size();
+    }
+};
+
+// ==================== 基准测试 ====================
+// 在合成名单上对比各实现的耗时, 名单规模不受 MAX_STUDENTS 限制
+namespace Benchmark {
+    constexpr int KERNEL_STUDENTS = 200000;
+    constexpr int REPEATS = 5;
+    
+    // 生成固定种子的合成名单, 成绩取 0-100 的整数
+    inline void makeRoster(std::vector<Student>& roster, int count, int courseCount, unsigned int seed) {
+        roster.assign(count, Student());
+        srand(seed);
+        for (int i = 0; i < count; i++) {
+            Student& st = roster[i];
+            memset(&st, 0, sizeof(st));
+            st.id = i;
+            sprintf(st.name, "s%d", i);
+            for (int j = 0; j < courseCount; j++) {
+                st.scores[j] = (float)(rand() % 101);
+            }
+        }
+    }
+    
+    // 执行 REPEATS 次, 返回最短一次的毫秒数
+    template <typename Fn>
+    inline double bestOfMs(Fn fn) {
+        double best = 0;
+        for (int r = 0; r < REPEATS; r++) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            double ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            if (r == 0 || ms < best) best = ms;
+        }
+        return best;
+    }
+    
+    // 按科目数特化的内核与运行期循环参考实现对比, 同时校验两者结果一致
+    inline void runKernels(FILE* out) {
+        static const int courseCounts[] = {2, 3, 6};
+        std::vector<Student> roster;
+        CourseStats specialized[Config::MAX_COURSES];
+        CourseStats reference[Config::MAX_COURSES];
+        
+        fprintf(out, "\n=== 统计内核 (%d 名学生, 取 %d 次最短) ===\n", KERNEL_STUDENTS, REPEATS);
+        fprintf(out, "%-10s%-16s%-14s%-14s%-10s%-8s\n", 
+                "Courses", "Kernel", "Runtime(ms)", "Fixed(ms)", "Speedup", "Match");
+        for (int i = 0; i < 72; i++) fputc('-', out);
+        fputc('\n', out);
+        
+        for (int c = 0; c < 3; c++) {
+            int courseCount = courseCounts[c];
+            makeRoster(roster, KERNEL_STUDENTS, courseCount, 2024);
+            Student* data = roster.data();
+            
+            double scoreRef = bestOfMs([&]() {
+                Kernels::computeStudentScoresReference(data, KERNEL_STUDENTS, courseCount);
+            });
+            std::vector<float> refTotals(KERNEL_STUDENTS);
+            std::vector<float> refAverages(KERNEL_STUDENTS);
+            for (int i = 0; i < KERNEL_STUDENTS; i++) {
+                refTotals[i] = data[i].totalScore;
+                refAverages[i] = data[i].avgScore;
+                data[i].totalScore = -1;
+                data[i].avgScore = -1;
+            }
+            double scoreFixed = bestOfMs([&]() {
+                Kernels::dispatchCourseCount(courseCount, [&](auto n) {
+                    Kernels::computeStudentScores<decltype(n)::value>(data, KERNEL_STUDENTS, courseCount);
+                });
+            });
+            // 成绩均为整数, 两条路径的累加结果应逐位相同
+            bool scoresMatch = true;
+            for (int i = 0; i < KERNEL_STUDENTS && scoresMatch; i++) {
+                scoresMatch = data[i].totalScore == refTotals[i] && data[i].avgScore == refAverages[i];
+            }
+            
+            double statsRef = bestOfMs([&]() {
+                Kernels::computeCourseStatsReference(data, KERNEL_STUDENTS, reference, courseCount);
+            });
+            double statsFixed = bestOfMs([&]() {
+                Kernels::dispatchCourseCount(courseCount, [&](auto n) {
+                    Kernels::computeCourseStats<decltype(n)::value>(data, KERNEL_STUDENTS, 
+                                                                     specialized, courseCount);
+                });
+            });
+            bool statsMatch = true;
+            for (int j = 0; j < courseCount; j++) {
+                statsMatch &= specialized[j].totalScore == reference[j].totalScore &&
+                              specialized[j].avgScore == reference[j].avgScore &&
+                              memcmp(specialized[j].gradeCount, reference[j].gradeCount, 
+                                     sizeof(reference[j].gradeCount)) == 0;
             }
+            
+            fprintf(out, "%-10d%-16s%-14.3f%-14.3f%-10.2f%-8s\n", courseCount, "studentScores",
+                    scoreRef, scoreFixed, scoreFixed > 0 ? scoreRef / scoreFixed : 0, 
+                    scoresMatch ? "yes" : "NO");
+            fprintf(out, "%-10d%-16s%-14.3f%-14.3f%-10.2f%-8s\n", courseCount, "courseStats",
+                    statsRef, statsFixed, statsFixed > 0 ? statsRef / statsFixed : 0, 
+                    statsMatch ? "yes" : "NO");
         }
     }
     
-    // 通用交换函数 - 消除重复代码
-    void swapStudents(int i, int j) {
-        Student temp = students[i];
-        students[i] = students[j];
-        students[j] = temp;
-    }
+    constexpr int GROUP_STUDENTS = 1000000;
     
-    // 按总分排序 (使用函数指针实现升序/降序)
-    void sortByTotalScore(bool ascending) {
-        for (int i = 0; i < studentCount - 1; i++) {
-            for (int j = 0; j < studentCount - 1 - i; j++) {
-                bool shouldSwap = ascending ? 
-                    (students[j].totalScore > students[j + 1].totalScore) :
-                    (students[j].totalScore < students[j + 1].totalScore);
-                if (shouldSwap) {
-                    swapStudents(j, j + 1);
-                }
-            }
+    // 分组聚合: 单线程与多线程对比, 覆盖高基数 (约 10 万组) 与低基数 (100 组) 分组
+    inline void runGroupBy(FILE* out) {
+        static const long divisors[] = {10, 10000};
+        const int courseCount = 3;
+        std::vector<Student> roster;
+        makeRoster(roster, GROUP_STUDENTS, courseCount, 2025);
+        // 不用 rand(): MSVC 的 RAND_MAX 只有 32767, 学号取不满 0-999999
+        std::mt19937 rng(2025);
+        std::uniform_int_distribution<long> idDist(0, 999999);
+        for (int i = 0; i < GROUP_STUDENTS; i++) {
+            roster[i].id = idDist(rng);
         }
-    }
-    
-    // 按学号排序
-    void sortById() {
-        for (int i = 0; i < studentCount - 1; i++) {
-            for (int j = 0; j < studentCount - 1 - i; j++) {
-                if (students[j].id > students[j + 1].id) {
-                    swapStudents(j, j + 1);
+        Kernels::computeStudentScoresReference(roster.data(), GROUP_STUDENTS, courseCount);
+        
+        // 至少开 4 个线程, 单核机器上也要走一遍多线程的分块与合并逻辑
+        int threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount < 4) threadCount = 4;
+        if (threadCount > Config::MAX_WORKER_THREADS) threadCount = Config::MAX_WORKER_THREADS;
+        
+        fprintf(out, "\n=== 分组统计 (%d 名学生, %d 线程, 取 %d 次最短) ===\n", 
+                GROUP_STUDENTS, threadCount, REPEATS);
+        fprintf(out, "%-10s%-10s%-14s%-14s%-10s%-8s\n", 
+                "Divisor", "Groups", "Serial(ms)", "Parallel(ms)", "Speedup", "Match");
+        for (int i = 0; i < 66; i++) fputc('-', out);
+        fputc('\n', out);
+        
+        for (int d = 0; d < 2; d++) {
+            std::vector<GroupStats> serial;
+            std::vector<GroupStats> parallel;
+            double serialMs = bestOfMs([&]() {
+                GroupAggregator::aggregateByIdPrefix(roster.data(), GROUP_STUDENTS, courseCount,
+                                                     divisors[d], serial, 1);
+            });
+            double parallelMs = bestOfMs([&]() {
+                GroupAggregator::aggregateByIdPrefix(roster.data(), GROUP_STUDENTS, courseCount,
+                                                     divisors[d], parallel, threadCount);
+            });
+            
+            // 按分组键排序后逐组比较; 成绩为整数, double 求和与分块方式无关, 可直接比较
+            GroupAggregator::sortGroups(serial, GROUP_SORT_KEY, true);
+            GroupAggregator::sortGroups(parallel, GROUP_SORT_KEY, true);
+            bool match = serial.size() == parallel.size();
+            for (size_t g = 0; match && g < serial.size(); g++) {
+                const GroupStats& a = serial[g];
+                const GroupStats& b = parallel[g];
+                match = a.key == b.key && a.count == b.count && a.totalSum == b.totalSum &&
+                        a.totalMin == b.totalMin && a.totalMax == b.totalMax &&
+                        memcmp(a.gradeCount, b.gradeCount, sizeof(a.gradeCount)) == 0;
+                for (int j = 0; match && j < courseCount; j++) {
+                    match = a.courseSum[j] == b.courseSum[j];
                 }
             }
+            
+            fprintf(out, "%-10ld%-10d%-14.3f%-14.3f%-10.2f%-8s\n", divisors[d], (int)serial.size(),
+                    serialMs, parallelMs, parallelMs > 0 ? serialMs / parallelMs : 0,
+                    match ? "yes" : "NO");
         }
     }
     
-    // 按姓名字典序排序
-    void sortByName() {
-        for (int i = 0; i < studentCount - 1; i++) {
-            for (int j = 0; j < studentCount - 1 - i; j++) {
-                if (strcmp(students[j].name, students[j + 1].name) > 0) {
-                    swapStudents(j, j + 1);
-                }
-            }
-        }
-    }
+    constexpr int DIFF_STUDENTS = 500000;
     
-    // 按学号查找，返回索引，-1表示未找到
-    int findById(long id) const {
-        for (int i = 0; i < studentCount; i++) {
-            if (students[i].id == id) return i;
+    // 名单对比: 单线程与多线程对比, 新名单在旧名单基础上做少量增删改并打乱顺序
+    inline void runDiff(FILE* out) {
+        const int courseCount = 3;
+        std::vector<Student> oldRoster;
+        makeRoster(oldRoster, DIFF_STUDENTS, courseCount, 2026);
+        for (int i = 0; i < DIFF_STUDENTS; i++) {
+            oldRoster[i].id = 100000000L + i;
         }
-        return -1;
-    }
-    
-    // 按姓名查找
-    int findByName(const char* name) const {
-        for (int i = 0; i < studentCount; i++) {
-            if (strcmp(students[i].name, name) == 0) return i;
+        
+        // 前 1% 删除, 接下来 1% 改成绩, 再追加 1% 新学号
+        int step = DIFF_STUDENTS / 100;
+        std::vector<Student> newRoster(oldRoster.begin() + step, oldRoster.end());
+        for (int i = 0; i < step; i++) {
+            newRoster[i].scores[i % courseCount] += 1;
         }
-        return -1;
-    }
-    
-    // 写入文件
-    bool saveToFile(const char* filepath) const {
-        FILE* file = fopen(filepath, "w");
-        if (!file) return false;
+        for (int i = 0; i < step; i++) {
+            Student st = oldRoster[i];
+            st.id = 200000000L + i;
+            newRoster.push_back(st);
+        }
+        // 不用 rand(): MSVC 的 RAND_MAX 只有 32767, 洗牌后大部分仍然有序
+        std::mt19937 rng(2026);
+        std::shuffle(newRoster.begin(), newRoster.end(), rng);
         
-        fprintf(file, "学生数量：%d\n", studentCount);
-        fprintf(file, "科目数量：%d\n", courseCount);
+        int threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount < 4) threadCount = 4;
+        if (threadCount > Config::MAX_WORKER_THREADS) threadCount = Config::MAX_WORKER_THREADS;
         
-        for (int i = 0; i < studentCount; i++) {
-            fprintf(file, "姓名: %s\n", students[i].name);
-            fprintf(file, "学号: %ld\n", students[i].id);
-            fprintf(file, "分数: ");
-            for (int j = 0; j < courseCount; j++) {
-                fprintf(file, "%.2f ", students[i].scores[j]);
+        std::vector<StudentChange> serial;
+        std::vector<StudentChange> parallel;
+        double serialMs = bestOfMs([&]() {
+            RosterDiff::diff(oldRoster.data(), DIFF_STUDENTS, newRoster.data(), (int)newRoster.size(),
+                             courseCount, serial, 1);
+        });
+        double parallelMs = bestOfMs([&]() {
+            RosterDiff::diff(oldRoster.data(), DIFF_STUDENTS, newRoster.data(), (int)newRoster.size(),
+                             courseCount, parallel, threadCount);
+        });
+        
+        int counts[3] = {0, 0, 0};
+        bool match = serial.size() == parallel.size();
+        for (size_t i = 0; i < serial.size(); i++) {
+            counts[serial[i].type]++;
+            if (match) {
+                match = serial[i].type == parallel[i].type && serial[i].oldIndex == parallel[i].oldIndex &&
+                        serial[i].newIndex == parallel[i].newIndex;
             }
-            fprintf(file, "\n总分: %.2f\n", students[i].totalScore);
-            fprintf(file, "平均分: %.2f\n\n", students[i].avgScore);
         }
+        match = match && counts[CHANGE_ADDED] == step && counts[CHANGE_REMOVED] == step && 
+                counts[CHANGE_MODIFIED] == step;
         
-        fclose(file);
-        return true;
+        fprintf(out, "\n=== 名单对比 (%d / %d 名学生, %d 线程, 取 %d 次最短) ===\n", 
+                DIFF_STUDENTS, (int)newRoster.size(), threadCount, REPEATS);
+        fprintf(out, "新增: %d  删除: %d  修改: %d\n", 
+                counts[CHANGE_ADDED], counts[CHANGE_REMOVED], counts[CHANGE_MODIFIED]);
+        fprintf(out, "%-14s%-14s%-10s%-8s\n", "Serial(ms)", "Parallel(ms)", "Speedup", "Match");
+        fprintf(out, "%-14.3f%-14.3f%-10.2f%-8s\n", serialMs, parallelMs,
+                parallelMs > 0 ? serialMs / parallelMs : 0, match ? "yes" : "NO");
     }
     
-    // 从文件读取
-    bool loadFromFile(const char* filepath) {
-        FILE* file = fopen(filepath, "r");
-        if (!file) return false;
+    constexpr int INDEX_STUDENTS = 300000;
+    constexpr int INDEX_LOOKUPS = 1000;
+    
+    // 索引文件: 直接从合成名单写出大文件, 再用单页缓存统计每次点查询实际读取的页数
+    inline void runIndex(FILE* out) {
+        const char* path = "index_benchmark.idx";
+        const int courseCount = 3;
+        std::vector<Student> roster;
+        makeRoster(roster, INDEX_STUDENTS, courseCount, 2027);
+        std::mt19937 rng(2027);
+        std::shuffle(roster.begin(), roster.end(), rng);
+        for (int i = 0; i < INDEX_STUDENTS; i++) {
+            roster[i].id += 100000000L;
+        }
         
-        if (fscanf(file, "学生数量：%d\n", &studentCount) != 1) {
-            fclose(file);
-            return false;
+        auto start = std::chrono::steady_clock::now();
+        bool written = IndexedRoster::write(roster.data(), INDEX_STUDENTS, courseCount, path);
+        double writeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        
+        fprintf(out, "\n=== 索引文件 (%d 名学生, %d 次查询) ===\n", INDEX_STUDENTS, INDEX_LOOKUPS);
+        IndexedRoster indexed(1);
+        if (!written || !indexed.open(path)) {
+            fprintf(out, "写入或打开索引文件失败\n");
+            remove(path);
+            return;
         }
-        if (fscanf(file, "科目数量：%d\n", &courseCount) != 1) {
-            fclose(file);
-            return false;
+        
+        // 缓存只有一页, 未命中数即读取的页数
+        std::uniform_int_distribution<int> pick(0, INDEX_STUDENTS - 1);
+        bool match = true;
+        unsigned long long idPages = indexed.pageCache().misses;
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < INDEX_LOOKUPS; q++) {
+            const Student& expected = roster[pick(rng)];
+            Student found;
+            match = indexed.findById(expected.id, found) && match &&
+                    strcmp(found.name, expected.name) == 0 && found.scores[0] == expected.scores[0];
         }
+        double idMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        idPages = indexed.pageCache().misses - idPages;
         
-        for (int i = 0; i < studentCount; i++) {
-            fscanf(file, "姓名: %s\n", students[i].name);
-            fscanf(file, "学号: %ld\n", &students[i].id);
-            fscanf(file, "分数: ");
-            for (int j = 0; j < courseCount; j++) {
-                fscanf(file, "%f", &students[i].scores[j]);
-            }
-            fscanf(file, "\n总分: %f\n", &students[i].totalScore);
-            fscanf(file, "平均分: %f\n\n", &students[i].avgScore);
+        unsigned long long namePages = indexed.pageCache().misses;
+        std::vector<Student> found;
+        for (int q = 0; q < INDEX_LOOKUPS; q++) {
+            const Student& expected = roster[pick(rng)];
+            match = indexed.findByName(expected.name, found, 1) == 1 && match && 
+                    found[0].id == expected.id;
         }
+        namePages = indexed.pageCache().misses - namePages;
+        indexed.close();
+        remove(path);
         
-        fclose(file);
-        return true;
+        fprintf(out, "写入: %.1f ms  单次学号查询: %.2f us, 读 %.2f 页  单次姓名查询: 读 %.2f 页  结果一致: %s\n",
+                writeMs, idMs * 1000 / INDEX_LOOKUPS, (double)idPages / INDEX_LOOKUPS,
+                (double)namePages / INDEX_LOOKUPS, match ? "yes" : "NO");
     }
-};
+}
 
 // ==================== GUI 组件 ====================
 
@@ -281,7 +2557,7 @@ struct Button {
 // 按钮管理器 - 统一管理菜单按钮
 class ButtonManager {
 public:
-    static constexpr int MAX_BUTTONS = 15;
+    static constexpr int MAX_BUTTONS = 20;
     Button buttons[MAX_BUTTONS];
     int buttonCount;
     
@@ -367,7 +2643,7 @@ public:
     static void drawStudentList(const StudentManager& mgr, int startY) {
         drawTableHeader(startY, mgr.courseCount);
         for (int i = 0; i < mgr.studentCount; i++) {
-            drawStudentRow(mgr.students[i], i, startY + Config::ROW_HEIGHT, mgr.courseCount);
+            drawStudentRow(mgr.students[mgr.studentAt(i)], i, startY + Config::ROW_HEIGHT, mgr.courseCount);
         }
     }
     
@@ -392,6 +2668,62 @@ public:
         }
     }
     
+    // 绘制 rows 中的学生及其派生列
+    static void drawMetricList(StudentManager& mgr, const int* metricIndices, int metricCount,
+                               const int* rows, int rowCount, int startY) {
+        outtextxy(10, startY, "ID");
+        outtextxy(100, startY, "Name");
+        for (int k = 0; k < metricCount; k++) {
+            outtextxy(200 + k * Config::COLUMN_WIDTH, startY, mgr.metrics[metricIndices[k]].name);
+        }
+        
+        for (int row = 0; row < rowCount; row++) {
+            char buffer[32];
+            int i = rows[row];
+            int y = startY + Config::ROW_HEIGHT + row * Config::ROW_HEIGHT;
+            
+            sprintf(buffer, "%ld", mgr.students[i].id);
+            outtextxy(10, y, buffer);
+            outtextxy(100, y, mgr.students[i].name);
+            for (int k = 0; k < metricCount; k++) {
+                sprintf(buffer, "%.2f", mgr.metricValue(metricIndices[k], i));
+                outtextxy(200 + k * Config::COLUMN_WIDTH, y, buffer);
+            }
+        }
+    }
+    
+    // 绘制分组统计
+    static void drawGroupStats(const std::vector<GroupStats>& groups, int startY) {
+        const char* headers[] = {"Group", "Count", "AvgTotal", "MinTotal", "MaxTotal", 
+                                 "A", "B", "C", "D", "E"};
+        for (int c = 0; c < 10; c++) {
+            outtextxy(10 + c * Config::COLUMN_WIDTH, startY, headers[c]);
+        }
+        
+        // 超出页面的分组不再绘制, 完整结果见控制台
+        int maxRows = (Config::DISPLAY_HEIGHT - 100 - startY) / Config::ROW_HEIGHT;
+        for (int i = 0; i < (int)groups.size() && i < maxRows; i++) {
+            const GroupStats& g = groups[i];
+            char buffer[32];
+            int y = startY + Config::ROW_HEIGHT + i * Config::ROW_HEIGHT;
+            
+            sprintf(buffer, "%ld", g.key);
+            outtextxy(10, y, buffer);
+            sprintf(buffer, "%d", g.count);
+            outtextxy(10 + Config::COLUMN_WIDTH, y, buffer);
+            sprintf(buffer, "%.2f", g.avgTotal());
+            outtextxy(10 + 2 * Config::COLUMN_WIDTH, y, buffer);
+            sprintf(buffer, "%.2f", g.totalMin);
+            outtextxy(10 + 3 * Config::COLUMN_WIDTH, y, buffer);
+            sprintf(buffer, "%.2f", g.totalMax);
+            outtextxy(10 + 4 * Config::COLUMN_WIDTH, y, buffer);
+            for (int k = 0; k < 5; k++) {
+                sprintf(buffer, "%d", g.gradeCount[k]);
+                outtextxy(10 + (5 + k) * Config::COLUMN_WIDTH, y, buffer);
+            }
+        }
+    }
+    
     // 绘制成绩分布统计
     static void drawGradeDistribution(const StudentManager& mgr, int startY) {
         const char* gradeLabels[] = {"A(90-100)", "B(80-89)", "C(70-79)", "D(60-69)", "E(<60)"};
@@ -420,8 +2752,8 @@ public:
 
 class ConsoleIO {
 public:
-    static bool inputStudentData(StudentManager& mgr) {
-        printf("\n=== 录入学生信息 ===\n");
+    // 录入过程中直接改写名单, 中途失败时只保留已完整录入的学生
+    static bool readStudentData(StudentManager& mgr) {
         printf("请输入学生人数 (1-%d): ", Config::MAX_STUDENTS);
         if (scanf("%d", &mgr.studentCount) != 1 || 
             mgr.studentCount <= 0 || mgr.studentCount > Config::MAX_STUDENTS) {
@@ -435,6 +2767,7 @@ public:
             mgr.courseCount <= 0 || mgr.courseCount > Config::MAX_COURSES) {
             printf("输入无效!\n");
             mgr.courseCount = 0;
+            mgr.studentCount = 0;
             return false;
         }
         
@@ -443,6 +2776,7 @@ public:
             printf("请输入学号和姓名: ");
             if (scanf("%ld %s", &mgr.students[i].id, mgr.students[i].name) != 2) {
                 printf("输入无效!\n");
+                mgr.studentCount = i;
                 return false;
             }
             
@@ -450,15 +2784,23 @@ public:
             for (int j = 0; j < mgr.courseCount; j++) {
                 if (scanf("%f", &mgr.students[i].scores[j]) != 1) {
                     printf("输入无效!\n");
+                    mgr.studentCount = i;
                     return false;
                 }
             }
         }
+        return true;
+    }
+    
+    static bool inputStudentData(StudentManager& mgr) {
+        printf("\n=== 录入学生信息 ===\n");
+        bool success = readStudentData(mgr);
         
+        // 无论成功与否名单都已改动, 都要重算成绩并作废派生视图
         mgr.calculateStudentScores();
         mgr.calculateCourseStats();
-        printf("\n录入成功!\n");
-        return true;
+        if (success) printf("\n录入成功!\n");
+        return success;
     }
     
     static void printStudentList(const StudentManager& mgr) {
@@ -471,12 +2813,29 @@ public:
         for (int i = 0; i < 10 * (mgr.courseCount + 4); i++) printf("-");
         printf("\n");
         
-        for (int i = 0; i < mgr.studentCount; i++) {
-            printf("%-10ld%-20s", mgr.students[i].id, mgr.students[i].name);
+        for (int row = 0; row < mgr.studentCount; row++) {
+            const Student& st = mgr.students[mgr.studentAt(row)];
+            printf("%-10ld%-20s", st.id, st.name);
             for (int j = 0; j < mgr.courseCount; j++) {
-                printf("%-10.2f", mgr.students[i].scores[j]);
+                printf("%-10.2f", st.scores[j]);
+            }
+            printf("%-10.2f%-10.2f\n", st.totalScore, st.avgScore);
+        }
+    }
+    
+    static void printStudents(const std::vector<Student>& list, int courseCount) {
+        printf("\n%-10s%-20s", "ID", "Name");
+        for (int j = 0; j < courseCount; j++) {
+            printf("%-10s", "Score");
+        }
+        printf("%-10s%-10s\n", "Total", "Average");
+        
+        for (size_t i = 0; i < list.size(); i++) {
+            printf("%-10ld%-20s", list[i].id, list[i].name);
+            for (int j = 0; j < courseCount; j++) {
+                printf("%-10.2f", list[i].scores[j]);
             }
-            printf("%-10.2f%-10.2f\n", mgr.students[i].totalScore, mgr.students[i].avgScore);
+            printf("%-10.2f%-10.2f\n", list[i].totalScore, list[i].avgScore);
         }
     }
     
@@ -524,6 +2883,157 @@ public:
         printf("%s", prompt);
         scanf("%s", path);
     }
+    
+    static TextCodec::Encoding inputFileEncoding() {
+        int choice;
+        printf("请选择文件编码 (0-GBK 1-UTF-8): ");
+        if (scanf("%d", &choice) != 1) return TextCodec::DEFAULT_FILE_ENCODING;
+        return choice == 1 ? TextCodec::ENCODING_UTF8 : TextCodec::ENCODING_GBK;
+    }
+    
+    static bool inputCourseWeights(float* weights, int courseCount) {
+        printf("请输入 %d 门课程的学分: ", courseCount);
+        for (int j = 0; j < Config::MAX_COURSES; j++) {
+            weights[j] = 0;
+        }
+        for (int j = 0; j < courseCount; j++) {
+            if (scanf("%f", &weights[j]) != 1 || weights[j] < 0) {
+                printf("输入无效!\n");
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // 读入绩点换算表, 档数为 0 时使用默认的 A-E 对应 4-0
+    static bool inputPointScale(PointScale* scale) {
+        int levels;
+        printf("请输入绩点换算档数 (0 使用默认 A-E 对应 4-0, 最多 %d): ", Config::MAX_POINT_LEVELS);
+        if (scanf("%d", &levels) != 1 || levels < 0 || levels > Config::MAX_POINT_LEVELS) {
+            printf("输入无效!\n");
+            return false;
+        }
+        if (levels == 0) {
+            *scale = PointScale::gradeScale();
+            return true;
+        }
+        
+        memset(scale, 0, sizeof(*scale));
+        for (int k = 0; k < levels; k++) {
+            printf("第 %d 档 (最低分 绩点): ", k + 1);
+            if (scanf("%f %f", &scale->minScore[k], &scale->points[k]) != 2) {
+                printf("输入无效!\n");
+                return false;
+            }
+        }
+        scale->levelCount = levels;
+        return true;
+    }
+    
+    static bool inputScoreChange(long* id, int* course, float* score, int courseCount) {
+        printf("请输入学号, 课程序号 (1-%d) 和新成绩: ", courseCount);
+        if (scanf("%ld %d %f", id, course, score) != 3 || *course < 1 || *course > courseCount) {
+            printf("输入无效!\n");
+            return false;
+        }
+        return true;
+    }
+    
+    static bool inputGroupOptions(long* divisor, int* sortKey) {
+        printf("请输入学号分组除数 (如 100 表示按学号去掉后两位分组): ");
+        if (scanf("%ld", divisor) != 1 || *divisor <= 0) {
+            printf("输入无效!\n");
+            return false;
+        }
+        printf("排序依据 (0-分组 1-人数 2-平均总分 3-最低总分 4-最高总分): ");
+        if (scanf("%d", sortKey) != 1 || *sortKey < 0 || *sortKey >= GROUP_SORT_COUNT_KEYS) {
+            printf("输入无效!\n");
+            return false;
+        }
+        return true;
+    }
+    
+    static void printGroupStats(const std::vector<GroupStats>& groups, int courseCount) {
+        printf("\n%-10s%-8s%-10s%-10s%-10s", "Group", "Count", "AvgTotal", "MinTotal", "MaxTotal");
+        for (int j = 0; j < courseCount; j++) {
+            printf("Course%-4d", j + 1);
+        }
+        printf("%-6s%-6s%-6s%-6s%-6s\n", "A", "B", "C", "D", "E");
+        
+        for (int i = 0; i < 48 + 10 * courseCount + 30; i++) printf("-");
+        printf("\n");
+        
+        for (size_t i = 0; i < groups.size(); i++) {
+            const GroupStats& g = groups[i];
+            printf("%-10ld%-8d%-10.2f%-10.2f%-10.2f", 
+                   g.key, g.count, g.avgTotal(), g.totalMin, g.totalMax);
+            for (int j = 0; j < courseCount; j++) {
+                printf("%-10.2f", g.courseAvg(j));
+            }
+            for (int k = 0; k < 5; k++) {
+                printf("%-6d", g.gradeCount[k]);
+            }
+            printf("\n");
+        }
+    }
+    
+    static void printRosterDiff(const std::vector<StudentChange>& changes,
+                                const StudentManager& oldMgr, const StudentManager& newMgr) {
+        int counts[3] = {0, 0, 0};
+        for (size_t i = 0; i < changes.size(); i++) {
+            counts[changes[i].type]++;
+        }
+        printf("\n=== 名单对比 ===\n");
+        printf("新增: %d  删除: %d  修改: %d\n", counts[CHANGE_ADDED], 
+               counts[CHANGE_REMOVED], counts[CHANGE_MODIFIED]);
+        
+        for (size_t i = 0; i < changes.size(); i++) {
+            const StudentChange& c = changes[i];
+            if (c.type == CHANGE_ADDED) {
+                printf("+ %-10ld%-20s\n", c.id, newMgr.students[c.newIndex].name);
+            } else if (c.type == CHANGE_REMOVED) {
+                printf("- %-10ld%-20s\n", c.id, oldMgr.students[c.oldIndex].name);
+            } else {
+                printf("~ %-10ld%-20s", c.id, newMgr.students[c.newIndex].name);
+                for (int j = 0; j < newMgr.courseCount; j++) {
+                    printf("%+-10.2f", c.delta[j]);
+                }
+                if (c.nameChanged) printf("(原姓名: %s)", oldMgr.students[c.oldIndex].name);
+                printf("\n");
+            }
+        }
+    }
+    
+    static bool inputMetricRange(const char* metricName, float* minValue, float* maxValue) {
+        printf("请输入%s筛选区间 (最低 最高, 最低为负数时不筛选): ", metricName);
+        if (scanf("%f %f", minValue, maxValue) != 2) {
+            printf("输入无效!\n");
+            return false;
+        }
+        return *minValue >= 0;
+    }
+    
+    // 打印 rows 中的学生, 附带若干派生列
+    static void printMetricList(StudentManager& mgr, const int* metricIndices, int metricCount,
+                                const int* rows, int rowCount) {
+        printf("\n%-10s%-20s", "ID", "Name");
+        for (int k = 0; k < metricCount; k++) {
+            printf("%-12s", mgr.metrics[metricIndices[k]].name);
+        }
+        printf("\n");
+        
+        for (int i = 0; i < 30 + 12 * metricCount; i++) printf("-");
+        printf("\n");
+        
+        for (int row = 0; row < rowCount; row++) {
+            int i = rows[row];
+            printf("%-10ld%-20s", mgr.students[i].id, mgr.students[i].name);
+            for (int k = 0; k < metricCount; k++) {
+                printf("%-12.2f", mgr.metricValue(metricIndices[k], i));
+            }
+            printf("\n");
+        }
+    }
 };
 
 // ==================== 菜单选项枚举 ====================
@@ -542,6 +3052,12 @@ enum MenuOption {
     MENU_LIST_ALL,
     MENU_SAVE_FILE,
     MENU_LOAD_FILE,
+    MENU_PROFILER,
+    MENU_WEIGHTED_GPA,
+    MENU_GROUP_STATS,
+    MENU_DIFF_FILE,
+    MENU_EDIT_SCORE,
+    MENU_INDEX_FILE,
     MENU_COUNT
 };
 
@@ -554,6 +3070,10 @@ private:
     IMAGE backgroundImg;
     bool isRunning;
     int lastSearchResult;
+    std::vector<GroupStats> lastGroups;
+    int lastMetricIndices[2];
+    int lastMetricRows[Config::MAX_STUDENTS];
+    int lastMetricRowCount;
     
     void initMenuButtons() {
         buttonMgr.clear();
@@ -575,6 +3095,14 @@ private:
         buttonMgr.addButton(400, 400, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "写入文件");
         buttonMgr.addButton(400, 450, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "读取文件");
         buttonMgr.addButton(400, 500, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "退出程序");
+        
+        // 底部一行
+        buttonMgr.addButton(100, 550, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "性能统计");
+        buttonMgr.addButton(400, 550, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "学分绩点");
+        buttonMgr.addButton(100, 600, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "分组统计");
+        buttonMgr.addButton(400, 600, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "对比文件");
+        buttonMgr.addButton(100, 650, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "修改成绩");
+        buttonMgr.addButton(400, 650, Config::BUTTON_WIDTH, Config::BUTTON_HEIGHT, YELLOW, "索引文件");
     }
     
     MenuOption showMenu() {
@@ -595,12 +3123,14 @@ private:
             int clicked = buttonMgr.getClickedButton(m);
             if (clicked >= 0) {
                 // 将按钮索引映射到菜单选项
-                // 按钮顺序: 0-6左列, 7-13右列
+                // 按钮顺序: 0-6左列, 7-13右列, 14之后为底部按钮
                 static const MenuOption buttonToOption[] = {
                     MENU_INPUT, MENU_CALC_COURSE_STATS, MENU_CALC_STUDENT_STATS,
                     MENU_SORT_SCORE_DESC, MENU_SORT_SCORE_ASC, MENU_SORT_ID, MENU_SORT_NAME,
                     MENU_SEARCH_ID, MENU_SEARCH_NAME, MENU_GRADE_DISTRIBUTION,
-                    MENU_LIST_ALL, MENU_SAVE_FILE, MENU_LOAD_FILE, MENU_EXIT
+                    MENU_LIST_ALL, MENU_SAVE_FILE, MENU_LOAD_FILE, MENU_EXIT,
+                    MENU_PROFILER, MENU_WEIGHTED_GPA, MENU_GROUP_STATS, MENU_DIFF_FILE,
+                    MENU_EDIT_SCORE, MENU_INDEX_FILE
                 };
                 result = buttonToOption[clicked];
                 break;
@@ -696,6 +3226,15 @@ private:
         GUIRenderer::drawCourseStats(studentMgr, offsetY);
     }
     
+    void drawMetricList() {
+        GUIRenderer::drawMetricList(studentMgr, lastMetricIndices, 2, 
+                                    lastMetricRows, lastMetricRowCount, 30);
+    }
+    
+    void drawGroupStats() {
+        GUIRenderer::drawGroupStats(lastGroups, 30);
+    }
+    
     // 处理各菜单选项
     void handleInput() {
         ConsoleIO::inputStudentData(studentMgr);
@@ -770,8 +3309,9 @@ private:
     void handleSaveFile() {
         char path[Config::MAX_PATH_LEN];
         ConsoleIO::inputFilePath(path, Config::MAX_PATH_LEN, "请输入保存路径: ");
+        TextCodec::Encoding encoding = ConsoleIO::inputFileEncoding();
         
-        bool success = studentMgr.saveToFile(path);
+        bool success = studentMgr.saveToFile(path, encoding);
         printf(success ? "写入文件成功\n" : "写入文件失败\n");
         showDisplayPage("写入文件", success ? "写入成功" : "写入失败", nullptr);
     }
@@ -782,7 +3322,8 @@ private:
         
         bool success = studentMgr.loadFromFile(path);
         if (success) {
-            printf("读取文件成功\n");
+            printf("读取文件成功 (编码: %s)\n", TextCodec::ENCODING_NAMES[studentMgr.lastFileEncoding]);
+            if (!studentMgr.lastFileValid) printf("文件中含有非法字符, 已替换\n");
             ConsoleIO::printStudentList(studentMgr);
         } else {
             printf("读取文件失败\n");
@@ -791,8 +3332,219 @@ private:
                        success ? &StudentManagementApp::drawStudentList : nullptr);
     }
     
+    void handleProfiler() {
+        printf("\n=== 性能统计 ===\n");
+        printf("统计: %s, Trace: %s\n", 
+               Profiler::isEnabled() ? "开启" : "关闭",
+               Profiler::isTracing() ? "开启" : "关闭");
+        printf("1. 开启/关闭统计  2. 开启/关闭Trace  3. 打印统计  4. 导出Trace  5. 清空  6. 基准测试  0. 返回\n");
+        printf("请选择: ");
+        
+        int choice;
+        if (scanf("%d", &choice) != 1) return;
+        
+        const char* status = "操作成功";
+        switch (choice) {
+            case 1:
+                Profiler::setEnabled(!Profiler::isEnabled());
+                if (!Profiler::isEnabled()) Profiler::setTracing(false);
+                break;
+            case 2:
+                Profiler::setTracing(!Profiler::isTracing());
+                break;
+            case 3:
+                Profiler::dump(stdout);
+                break;
+            case 4: {
+                char path[Config::MAX_PATH_LEN];
+                ConsoleIO::inputFilePath(path, Config::MAX_PATH_LEN, "请输入Trace保存路径: ");
+                bool success = Profiler::writeTrace(path);
+                printf(success ? "导出成功\n" : "导出失败\n");
+                status = success ? "导出成功" : "导出失败";
+                break;
+            }
+            case 5:
+                Profiler::reset();
+                break;
+            case 6:
+                Benchmark::runKernels(stdout);
+                Benchmark::runGroupBy(stdout);
+                Benchmark::runDiff(stdout);
+                Benchmark::runIndex(stdout);
+                break;
+            default:
+                return;
+        }
+        showDisplayPage("性能统计", status, nullptr);
+    }
+    
+    void handleWeightedGpa() {
+        MetricFormula formula;
+        memset(&formula, 0, sizeof(formula));
+        formula.aggregate = METRIC_WEIGHTED_AVERAGE;
+        if (!ConsoleIO::inputCourseWeights(formula.weights, studentMgr.courseCount) ||
+            !ConsoleIO::inputPointScale(&formula.scale)) {
+            showDisplayPage("学分绩点", "输入无效", nullptr);
+            return;
+        }
+        
+        // 重复定义同名指标只会更新公式; 两个指标共用学分, 绩点列另经换算表映射
+        int* metricIndices = lastMetricIndices;
+        metricIndices[0] = studentMgr.defineMetric("加权均分", formula);
+        formula.usePoints = true;
+        metricIndices[1] = studentMgr.defineMetric("学分绩点", formula);
+        if (metricIndices[0] < 0 || metricIndices[1] < 0) {
+            showDisplayPage("学分绩点", "指标数量已达上限", nullptr);
+            return;
+        }
+        
+        studentMgr.sortByMetric(metricIndices[1], false);
+        
+        // 可选按绩点区间筛选, 筛选结果仍按绩点降序排列
+        bool selected[Config::MAX_STUDENTS];
+        float minValue, maxValue;
+        bool filtered = ConsoleIO::inputMetricRange("学分绩点", &minValue, &maxValue);
+        if (filtered) {
+            int matches[Config::MAX_STUDENTS];
+            int matchCount = studentMgr.filterByMetric(metricIndices[1], minValue, maxValue, matches);
+            memset(selected, 0, sizeof(selected));
+            for (int k = 0; k < matchCount; k++) {
+                selected[matches[k]] = true;
+            }
+        }
+        
+        lastMetricRowCount = 0;
+        for (int row = 0; row < studentMgr.studentCount; row++) {
+            int i = studentMgr.studentAt(row);
+            if (!filtered || selected[i]) lastMetricRows[lastMetricRowCount++] = i;
+        }
+        
+        ConsoleIO::printMetricList(studentMgr, metricIndices, 2, lastMetricRows, lastMetricRowCount);
+        showDisplayPage("学分绩点降序", filtered ? "筛选成功" : "计算成功", 
+                        &StudentManagementApp::drawMetricList);
+    }
+    
+    void handleGroupStats() {
+        long divisor;
+        int sortKey;
+        if (!ConsoleIO::inputGroupOptions(&divisor, &sortKey)) {
+            showDisplayPage("分组统计", "输入无效", nullptr);
+            return;
+        }
+        
+        GroupAggregator::aggregateByIdPrefix(studentMgr, divisor, lastGroups);
+        GroupAggregator::sortGroups(lastGroups, (GroupSortKey)sortKey, sortKey == GROUP_SORT_KEY);
+        ConsoleIO::printGroupStats(lastGroups, studentMgr.courseCount);
+        showDisplayPage("分组统计", "统计成功", &StudentManagementApp::drawGroupStats);
+    }
+    
+    void handleDiffFile() {
+        char path[Config::MAX_PATH_LEN];
+        ConsoleIO::inputFilePath(path, Config::MAX_PATH_LEN, "请输入要对比的新名单路径: ");
+        
+        // 另一份名单体积较大, 放在堆上
+        std::unique_ptr<StudentManager> newMgr(new StudentManager());
+        if (!newMgr->loadFromFile(path)) {
+            printf("读取文件失败\n");
+            showDisplayPage("对比文件", "读取失败", nullptr);
+            return;
+        }
+        
+        std::vector<StudentChange> changes;
+        if (!RosterDiff::diff(studentMgr, *newMgr, changes)) {
+            printf("两份名单科目数量不一致 (%d / %d), 无法对比\n", 
+                   studentMgr.courseCount, newMgr->courseCount);
+            showDisplayPage("对比文件", "科目数量不一致", nullptr);
+            return;
+        }
+        ConsoleIO::printRosterDiff(changes, studentMgr, *newMgr);
+        
+        ConsoleIO::inputFilePath(path, Config::MAX_PATH_LEN, "请输入编辑批次保存路径 (输入 - 跳过): ");
+        const char* status = "对比成功";
+        if (strcmp(path, "-") != 0) {
+            bool success = RosterDiff::writeEditBatch(path, changes, *newMgr);
+            printf(success ? "写入文件成功\n" : "写入文件失败\n");
+            status = success ? "对比成功, 已写入编辑批次" : "对比成功, 编辑批次写入失败";
+        }
+        showDisplayPage("对比文件", status, nullptr);
+    }
+    
+    void handleEditScore() {
+        long id;
+        int course;
+        float score;
+        if (!ConsoleIO::inputScoreChange(&id, &course, &score, studentMgr.courseCount)) {
+            showDisplayPage("修改成绩", "输入无效", nullptr);
+            return;
+        }
+        
+        int index = studentMgr.findById(id);
+        bool success = studentMgr.setScore(index, course - 1, score);
+        if (success) {
+            printf("修改成功\n");
+            ConsoleIO::printStudentList(studentMgr);
+        } else {
+            printf("未找到匹配的学生\n");
+        }
+        showDisplayPage("修改成绩", success ? "修改成功" : "修改失败",
+                       success ? &StudentManagementApp::drawStudentList : nullptr);
+    }
+    
+    void handleIndexFile() {
+        printf("\n=== 索引文件 ===\n");
+        printf("1. 由当前数据生成索引文件  2. 按学号查询  3. 按学号区间查询  4. 按姓名查询  0. 返回\n");
+        printf("请选择: ");
+        
+        int choice;
+        if (scanf("%d", &choice) != 1 || choice < 1 || choice > 4) return;
+        
+        char path[Config::MAX_PATH_LEN];
+        ConsoleIO::inputFilePath(path, Config::MAX_PATH_LEN, "请输入索引文件路径: ");
+        
+        if (choice == 1) {
+            bool success = IndexedRoster::write(studentMgr, path);
+            printf(success ? "写入文件成功\n" : "写入文件失败\n");
+            showDisplayPage("索引文件", success ? "写入成功" : "写入失败", nullptr);
+            return;
+        }
+        
+        IndexedRoster roster;
+        if (!roster.open(path)) {
+            printf("读取文件失败\n");
+            showDisplayPage("索引文件", "读取失败", nullptr);
+            return;
+        }
+        
+        std::vector<Student> results;
+        if (choice == 2 || choice == 3) {
+            long minId = ConsoleIO::inputIdForSearch();
+            long maxId = minId;
+            if (choice == 3) maxId = ConsoleIO::inputIdForSearch();
+            roster.findByIdRange(minId, maxId, results, Config::MAX_STUDENTS);
+        } else {
+            char name[Config::MAX_NAME_LEN];
+            ConsoleIO::inputNameForSearch(name, Config::MAX_NAME_LEN);
+            roster.findByName(name, results, Config::MAX_STUDENTS);
+        }
+        
+        ConsoleIO::printStudents(results, roster.courseCount());
+        printf("读取页数: %llu, 缓存命中: %llu\n", 
+               roster.pageCache().misses, roster.pageCache().hits);
+        showDisplayPage("索引文件", results.empty() ? "查询失败" : "查询成功", nullptr);
+    }
+    
 public:
-    StudentManagementApp() : isRunning(true), lastSearchResult(-1) {}
+    StudentManagementApp() : isRunning(true), lastSearchResult(-1), lastMetricRowCount(0) {
+        // 环境变量 SIMS_PROFILE 开启统计, SIMS_TRACE 指定 trace 输出路径
+        if (getenv("SIMS_PROFILE")) Profiler::setEnabled(true);
+        if (getenv("SIMS_TRACE")) Profiler::setTracing(true);
+    }
+    
+    ~StudentManagementApp() {
+        if (Profiler::isEnabled()) Profiler::dump(stdout);
+        const char* tracePath = getenv("SIMS_TRACE");
+        if (tracePath) Profiler::writeTrace(tracePath);
+    }
     
     void run() {
         // 使用循环替代递归，避免栈溢出
@@ -813,6 +3565,12 @@ public:
                 case MENU_LIST_ALL:           handleListAll(); break;
                 case MENU_SAVE_FILE:          handleSaveFile(); break;
                 case MENU_LOAD_FILE:          handleLoadFile(); break;
+                case MENU_PROFILER:           handleProfiler(); break;
+                case MENU_WEIGHTED_GPA:       handleWeightedGpa(); break;
+                case MENU_GROUP_STATS:        handleGroupStats(); break;
+                case MENU_DIFF_FILE:          handleDiffFile(); break;
+                case MENU_EDIT_SCORE:         handleEditScore(); break;
+                case MENU_INDEX_FILE:         handleIndexFile(); break;
                 case MENU_EXIT:               isRunning = false; break;
                 default: break;
             }